@@ -32,7 +32,7 @@
  * compatible, thus CINDEX_VERSION_MAJOR is expected to remain stable.
  */
 #define CINDEX_VERSION_MAJOR 0
-#define CINDEX_VERSION_MINOR 43
+#define CINDEX_VERSION_MINOR 44
 
 #define CINDEX_VERSION_ENCODE(major, minor) ( \
       ((major) * 10000)                       \
@@ -1239,7 +1239,19 @@ enum CXTranslationUnit_Flags {
   /**
    * \brief Sets the preprocessor in a mode for parsing a single file only.
    */
-  CXTranslationUnit_SingleFileParse = 0x400
+  CXTranslationUnit_SingleFileParse = 0x400,
+
+  /**
+   * \brief Used to indicate that only declarations are of interest.
+   *
+   * This implies \c CXTranslationUnit_SkipFunctionBodies, and additionally
+   * avoids the semantic analysis that only matters for function definitions:
+   * implicit special member definitions, vtables, implicit instantiations of
+   * function definitions and eager constant evaluation are skipped. The bodies
+   * of functions that may be needed to analyze declarations, such as constexpr
+   * functions, are still parsed.
+   */
+  CXTranslationUnit_ParseDeclarationsOnly = 0x800
 };
 
 /**
@@ -621,9 +621,31 @@ public:
     return BumpAlloc;
   }
 
+  /// \brief The kinds of AST nodes whose memory is accounted for separately
+  /// in the statistics.
+  enum AllocationCategory {
+    AC_Decl,
+    AC_Type,
+    AC_Stmt,
+    AC_TemplateArgumentList,
+    AC_Attr,
+    NumAllocationCategories
+  };
+
+private:
+  /// \brief The number of bytes allocated for each category of AST nodes.
+  mutable size_t CategoryAllocatedMemory[NumAllocationCategories] = {};
+
+public:
   void *Allocate(size_t Size, unsigned Align = 8) const {
     return BumpAlloc.Allocate(Size, Align);
   }
+  /// \brief Allocate memory for an AST node of the given category.
+  void *Allocate(size_t Size, unsigned Align,
+                 AllocationCategory Category) const {
+    CategoryAllocatedMemory[Category] += Size;
+    return BumpAlloc.Allocate(Size, Align);
+  }
   template <typename T> T *Allocate(size_t Num = 1) const {
     return static_cast<T *>(Allocate(Num * sizeof(T), alignof(T)));
   }
@@ -634,8 +656,24 @@ public:
   size_t getASTAllocatedMemory() const {
     return BumpAlloc.getTotalMemory();
   }
+  /// Return the number of bytes allocated for AST nodes of the given
+  /// category.
+  size_t getASTAllocatedMemory(AllocationCategory Category) const {
+    return CategoryAllocatedMemory[Category];
+  }
   /// Return the total memory used for various side tables.
   size_t getSideTableAllocatedMemory() const;
+  /// Return the total memory used for the name lookup tables of declaration
+  /// contexts.
+  size_t getDeclContextLookupMemory() const;
+
+  /// \brief Print the breakdown of the memory used by this context, in bytes,
+  /// as a JSON object.
+  void printMemoryStatsJSON(raw_ostream &OS) const;
+
+  /// \brief Print the number of types of each class in this context and their
+  /// size in bytes, not counting trailing storage, as a JSON object.
+  void printTypeStatsJSON(raw_ostream &OS) const;
 
   PartialDiagnostic::StorageAllocator &getDiagAllocator() {
     return DiagAllocator;
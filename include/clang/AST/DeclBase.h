@@ -922,6 +922,10 @@ public:
   static void add(Kind k);
   static void EnableStatistics();
   static void PrintStats();
+  /// \brief Print the number of declarations of each kind and their size in
+  /// bytes, as a JSON object.
+  static void PrintStatsJSON(raw_ostream &OS);
+  static void ResetStatistics();
 
   /// isTemplateParameter - Determines whether this declaration is a
   /// template parameter.
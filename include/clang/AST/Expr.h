@@ -2197,6 +2197,29 @@ public:
   }
 };
 
+/// \brief The arguments of a call or a constructor call as written.
+///
+/// They are only kept when some of them are designated, in which case they
+/// differ from the arguments the callee is called with.
+class SyntacticCallArgs final
+    : private llvm::TrailingObjects<SyntacticCallArgs, Expr *> {
+  friend TrailingObjects;
+
+  unsigned NumArgs;
+
+  SyntacticCallArgs(ArrayRef<Expr *> Args) : NumArgs(Args.size()) {
+    std::uninitialized_copy(Args.begin(), Args.end(),
+                            getTrailingObjects<Expr *>());
+  }
+
+public:
+  static SyntacticCallArgs *Create(const ASTContext &C, ArrayRef<Expr *> Args);
+
+  ArrayRef<Expr *> args() const {
+    return {getTrailingObjects<Expr *>(), NumArgs};
+  }
+};
+
 /// CallExpr - Represents a function call (C99 6.5.2.2, C++ [expr.call]).
 /// CallExpr itself represents a normal function call, e.g., "f(x, 2)",
 /// while its subclasses may represent alternative syntax that (semantically)
@@ -2206,9 +2229,8 @@ public:
 class CallExpr : public Expr {
   enum { FN=0, PREARGS_START=1 };
   Stmt **SubExprs;
-  Expr **SyntacticArgs;
+  SyntacticCallArgs *SyntacticArgs;
   unsigned NumArgs;
-  unsigned NumSyntacticArgs;
   SourceLocation RParenLoc;
 
   void updateDependenciesFromArg(Expr *Arg);
@@ -2298,7 +2320,7 @@ public:
   void setSyntacticArgs(const ASTContext &C, ArrayRef<Expr *> Args);
 
   ArrayRef<Expr *> getSyntacticArgs() const {
-    return {SyntacticArgs, NumSyntacticArgs};
+    return SyntacticArgs ? SyntacticArgs->args() : ArrayRef<Expr *>();
   }
 
   typedef ExprIterator arg_iterator;
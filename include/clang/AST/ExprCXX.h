@@ -1174,6 +1174,9 @@ public:
 };
 
 /// \brief Represents a call to a C++ constructor.
+///
+/// The arguments are stored right after the expression, whose size depends
+/// on whether it is a CXXTemporaryObjectExpr.
 class CXXConstructExpr : public Expr {
 public:
   enum ConstructionKind {
@@ -1185,24 +1188,34 @@ public:
 
 private:
   CXXConstructorDecl *Constructor;
+  SyntacticCallArgs *SyntacticArgs;
 
   SourceLocation Loc;
   SourceRange ParenOrBraceRange;
-  unsigned NumArgs : 12;
-  unsigned NumSyntacticArgs : 12;
-  unsigned Elidable : 1;
-  unsigned HadMultipleCandidates : 1;
-  unsigned ListInitialization : 1;
-  unsigned StdInitListInitialization : 1;
-  unsigned ZeroInitialization : 1;
-  unsigned ConstructKind : 2;
-  Stmt **Args;
-  Expr **SyntacticArgs;
+  unsigned NumArgs;
 
   void setConstructor(CXXConstructorDecl *C) { Constructor = C; }
 
+  Stmt **getTrailingArgs() {
+    return reinterpret_cast<Stmt **>(reinterpret_cast<char *>(this) +
+                                     offsetToTrailingArgs(getStmtClass()));
+  }
+  Stmt *const *getTrailingArgs() const {
+    return const_cast<CXXConstructExpr *>(this)->getTrailingArgs();
+  }
+
 protected:
-  CXXConstructExpr(const ASTContext &C, StmtClass SC, QualType T,
+  /// \brief Return the offset of the arguments from the start of a
+  /// construction expression of class \p SC.
+  static unsigned offsetToTrailingArgs(StmtClass SC);
+
+  /// \brief Return the size of a construction expression of class \p SC
+  /// with \p NumArgs arguments.
+  static unsigned sizeToAllocate(StmtClass SC, unsigned NumArgs) {
+    return offsetToTrailingArgs(SC) + NumArgs * sizeof(Stmt *);
+  }
+
+  CXXConstructExpr(StmtClass SC, QualType T,
                    SourceLocation Loc,
                    CXXConstructorDecl *Ctor,
                    bool Elidable,
@@ -1215,17 +1228,9 @@ protected:
                    SourceRange ParenOrBraceRange);
 
   /// \brief Construct an empty C++ construction expression.
-  CXXConstructExpr(StmtClass SC, EmptyShell Empty)
-      : Expr(SC, Empty), Constructor(nullptr), NumArgs(0), NumSyntacticArgs(0),
-        Elidable(false), HadMultipleCandidates(false),
-        ListInitialization(false), ZeroInitialization(false), ConstructKind(0),
-        Args(nullptr), SyntacticArgs(nullptr) {}
+  CXXConstructExpr(StmtClass SC, EmptyShell Empty, unsigned NumArgs);
 
 public:
-  /// \brief Construct an empty C++ construction expression.
-  explicit CXXConstructExpr(EmptyShell Empty)
-    : CXXConstructExpr(CXXConstructExprClass, Empty) {}
-
   static CXXConstructExpr *Create(const ASTContext &C, QualType T,
                                   SourceLocation Loc,
                                   CXXConstructorDecl *Ctor,
@@ -1238,6 +1243,10 @@ public:
                                   ConstructionKind ConstructKind,
                                   SourceRange ParenOrBraceRange);
 
+  /// \brief Create an empty C++ construction expression with room for
+  /// \p NumArgs arguments.
+  static CXXConstructExpr *CreateEmpty(const ASTContext &C, unsigned NumArgs);
+
   /// \brief Get the constructor that this expression will (ultimately) call.
   CXXConstructorDecl *getConstructor() const { return Constructor; }
 
@@ -1245,39 +1254,53 @@ public:
   void setLocation(SourceLocation Loc) { this->Loc = Loc; }
 
   /// \brief Whether this construction is elidable.
-  bool isElidable() const { return Elidable; }
-  void setElidable(bool E) { Elidable = E; }
+  bool isElidable() const { return CXXConstructExprBits.Elidable; }
+  void setElidable(bool E) { CXXConstructExprBits.Elidable = E; }
 
   /// \brief Whether the referred constructor was resolved from
   /// an overloaded set having size greater than 1.
-  bool hadMultipleCandidates() const { return HadMultipleCandidates; }
-  void setHadMultipleCandidates(bool V) { HadMultipleCandidates = V; }
+  bool hadMultipleCandidates() const {
+    return CXXConstructExprBits.HadMultipleCandidates;
+  }
+  void setHadMultipleCandidates(bool V) {
+    CXXConstructExprBits.HadMultipleCandidates = V;
+  }
 
   /// \brief Whether this constructor call was written as list-initialization.
-  bool isListInitialization() const { return ListInitialization; }
-  void setListInitialization(bool V) { ListInitialization = V; }
+  bool isListInitialization() const {
+    return CXXConstructExprBits.ListInitialization;
+  }
+  void setListInitialization(bool V) {
+    CXXConstructExprBits.ListInitialization = V;
+  }
 
   /// \brief Whether this constructor call was written as list-initialization,
   /// but was interpreted as forming a std::initializer_list<T> from the list
   /// and passing that as a single constructor argument.
   /// See C++11 [over.match.list]p1 bullet 1.
-  bool isStdInitListInitialization() const { return StdInitListInitialization; }
-  void setStdInitListInitialization(bool V) { StdInitListInitialization = V; }
+  bool isStdInitListInitialization() const {
+    return CXXConstructExprBits.StdInitListInitialization;
+  }
+  void setStdInitListInitialization(bool V) {
+    CXXConstructExprBits.StdInitListInitialization = V;
+  }
 
   /// \brief Whether this construction first requires
   /// zero-initialization before the initializer is called.
-  bool requiresZeroInitialization() const { return ZeroInitialization; }
+  bool requiresZeroInitialization() const {
+    return CXXConstructExprBits.ZeroInitialization;
+  }
   void setRequiresZeroInitialization(bool ZeroInit) {
-    ZeroInitialization = ZeroInit;
+    CXXConstructExprBits.ZeroInitialization = ZeroInit;
   }
 
   /// \brief Determine whether this constructor is actually constructing
   /// a base class (rather than a complete object).
   ConstructionKind getConstructionKind() const {
-    return (ConstructionKind)ConstructKind;
+    return (ConstructionKind)CXXConstructExprBits.ConstructionKind;
   }
   void setConstructionKind(ConstructionKind CK) {
-    ConstructKind = CK;
+    CXXConstructExprBits.ConstructionKind = CK;
   }
 
   typedef ExprIterator arg_iterator;
@@ -1290,12 +1313,12 @@ public:
     return arg_const_range(arg_begin(), arg_end());
   }
 
-  arg_iterator arg_begin() { return Args; }
-  arg_iterator arg_end() { return Args + NumArgs; }
-  const_arg_iterator arg_begin() const { return Args; }
-  const_arg_iterator arg_end() const { return Args + NumArgs; }
+  arg_iterator arg_begin() { return getTrailingArgs(); }
+  arg_iterator arg_end() { return getTrailingArgs() + NumArgs; }
+  const_arg_iterator arg_begin() const { return getTrailingArgs(); }
+  const_arg_iterator arg_end() const { return getTrailingArgs() + NumArgs; }
 
-  Expr **getArgs() { return reinterpret_cast<Expr **>(Args); }
+  Expr **getArgs() { return reinterpret_cast<Expr **>(getTrailingArgs()); }
   const Expr *const *getArgs() const {
     return const_cast<CXXConstructExpr *>(this)->getArgs();
   }
@@ -1304,23 +1327,23 @@ public:
   void setSyntacticArgs(const ASTContext &C, ArrayRef<Expr *> Args);
 
   ArrayRef<Expr *> getSyntacticArgs() const {
-    return {SyntacticArgs, NumSyntacticArgs};
+    return SyntacticArgs ? SyntacticArgs->args() : ArrayRef<Expr *>();
   }
 
   /// \brief Return the specified argument.
   Expr *getArg(unsigned Arg) {
     assert(Arg < NumArgs && "Arg access out of range!");
-    return cast<Expr>(Args[Arg]);
+    return cast<Expr>(getTrailingArgs()[Arg]);
   }
   const Expr *getArg(unsigned Arg) const {
     assert(Arg < NumArgs && "Arg access out of range!");
-    return cast<Expr>(Args[Arg]);
+    return cast<Expr>(getTrailingArgs()[Arg]);
   }
 
   /// \brief Set the specified argument.
   void setArg(unsigned Arg, Expr *ArgExpr) {
     assert(Arg < NumArgs && "Arg access out of range!");
-    Args[Arg] = ArgExpr;
+    getTrailingArgs()[Arg] = ArgExpr;
   }
 
   SourceLocation getLocStart() const LLVM_READONLY;
@@ -1335,7 +1358,7 @@ public:
 
   // Iterators
   child_range children() {
-    return child_range(&Args[0], &Args[0]+NumArgs);
+    return child_range(getTrailingArgs(), getTrailingArgs() + NumArgs);
   }
 
   friend class ASTStmtReader;
@@ -1477,9 +1500,7 @@ public:
 class CXXTemporaryObjectExpr : public CXXConstructExpr {
   TypeSourceInfo *Type;
 
-public:
-  CXXTemporaryObjectExpr(const ASTContext &C,
-                         CXXConstructorDecl *Cons,
+  CXXTemporaryObjectExpr(CXXConstructorDecl *Cons,
                          QualType Type,
                          TypeSourceInfo *TSI,
                          ArrayRef<Expr *> Args,
@@ -1488,8 +1509,25 @@ public:
                          bool ListInitialization,
                          bool StdInitListInitialization,
                          bool ZeroInitialization);
-  explicit CXXTemporaryObjectExpr(EmptyShell Empty)
-    : CXXConstructExpr(CXXTemporaryObjectExprClass, Empty), Type() { }
+  CXXTemporaryObjectExpr(EmptyShell Empty, unsigned NumArgs)
+    : CXXConstructExpr(CXXTemporaryObjectExprClass, Empty, NumArgs), Type() {}
+
+public:
+  static CXXTemporaryObjectExpr *Create(const ASTContext &C,
+                                        CXXConstructorDecl *Cons,
+                                        QualType Type,
+                                        TypeSourceInfo *TSI,
+                                        ArrayRef<Expr *> Args,
+                                        SourceRange ParenOrBraceRange,
+                                        bool HadMultipleCandidates,
+                                        bool ListInitialization,
+                                        bool StdInitListInitialization,
+                                        bool ZeroInitialization);
+
+  /// \brief Create an empty temporary object expression with room for
+  /// \p NumArgs arguments.
+  static CXXTemporaryObjectExpr *CreateEmpty(const ASTContext &C,
+                                             unsigned NumArgs);
 
   TypeSourceInfo *getTypeSourceInfo() const { return Type; }
 
@@ -1503,6 +1541,13 @@ public:
   friend class ASTStmtReader;
 };
 
+inline unsigned CXXConstructExpr::offsetToTrailingArgs(StmtClass SC) {
+  if (SC == CXXTemporaryObjectExprClass)
+    return sizeof(CXXTemporaryObjectExpr);
+  assert(SC == CXXConstructExprClass && "not a construction expression");
+  return sizeof(CXXConstructExpr);
+}
+
 /// \brief A C++ lambda expression, which produces a function object
 /// (of unspecified type) that can be invoked later.
 ///
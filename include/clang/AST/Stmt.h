@@ -194,6 +194,18 @@ protected:
     unsigned NumPreArgs : 1;
   };
 
+  class CXXConstructExprBitfields {
+    friend class CXXConstructExpr;
+    unsigned : NumExprBits;
+
+    unsigned Elidable : 1;
+    unsigned HadMultipleCandidates : 1;
+    unsigned ListInitialization : 1;
+    unsigned StdInitListInitialization : 1;
+    unsigned ZeroInitialization : 1;
+    unsigned ConstructionKind : 2;
+  };
+
   class ExprWithCleanupsBitfields {
     friend class ExprWithCleanups;
     friend class ASTStmtReader; // deserialization
@@ -272,6 +284,7 @@ protected:
     DeclRefExprBitfields DeclRefExprBits;
     CastExprBitfields CastExprBits;
     CallExprBitfields CallExprBits;
+    CXXConstructExprBitfields CXXConstructExprBits;
     ExprWithCleanupsBitfields ExprWithCleanupsBits;
     PseudoObjectExprBitfields PseudoObjectExprBits;
     ObjCIndirectCopyRestoreExprBitfields ObjCIndirectCopyRestoreExprBits;
@@ -374,6 +387,10 @@ public:
   static void addStmtClass(const StmtClass s);
   static void EnableStatistics();
   static void PrintStats();
+  /// \brief Print the number of statements and expressions of each class and
+  /// their size in bytes, as a JSON object.
+  static void PrintStatsJSON(raw_ostream &OS);
+  static void ResetStatistics();
 
   /// \brief Dumps the specified AST fragment and all subtrees to
   /// \c llvm::errs().
@@ -1586,6 +1586,14 @@ protected:
   }
 
 public:
+  // Only allow allocation of Types using the allocator in ASTContext, which
+  // accounts for their memory separately, or by doing a placement new.
+  void *operator new(size_t Bytes, const ASTContext &C, size_t Alignment = 8);
+  void *operator new(size_t Bytes, void *Mem) noexcept { return Mem; }
+
+  void operator delete(void *, const ASTContext &, size_t) noexcept {}
+  void operator delete(void *, void *) noexcept {}
+
   TypeClass getTypeClass() const { return static_cast<TypeClass>(TypeBits.TC); }
 
   /// \brief Whether this type comes from an AST file.
@@ -20,6 +20,7 @@
 #include "clang/Basic/SourceLocation.h"
 #include "clang/Basic/Specifiers.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/iterator_range.h"
@@ -260,6 +261,8 @@ private:
       Files.clear();
       FirstDiagState = CurDiagState = nullptr;
       CurDiagStateLoc = SourceLocation();
+      LastLookupFID = FileID();
+      LastLookupFile = nullptr;
     }
 
     /// Grab the most-recently-added state point.
@@ -309,6 +312,11 @@ private:
     /// The location at which the current diagnostic state was established.
     SourceLocation CurDiagStateLoc;
 
+    /// The file of the most recent lookup. Consecutive lookups are usually in
+    /// the same file, and the nodes of \c Files are never moved.
+    mutable FileID LastLookupFID;
+    mutable const File *LastLookupFile = nullptr;
+
     /// Get the diagnostic state information for a file.
     File *getFile(SourceManager &SrcMgr, FileID ID) const;
 
@@ -328,6 +336,26 @@ private:
 
   void PushDiagStatePoint(DiagState *State, SourceLocation L);
 
+  /// \brief The builtin diagnostics known to be ignored in every DiagState,
+  /// among those whose bit in \c NeverEnabledKnown is set.
+  ///
+  /// Known bits are reset whenever a mapping change might enable a
+  /// diagnostic somewhere, so that \c isIgnored() can answer for disabled
+  /// warnings without looking up the state at their location.
+  mutable llvm::BitVector NeverEnabled;
+  mutable llvm::BitVector NeverEnabledKnown;
+
+  /// \brief Determine whether \p DiagID is ignored in every DiagState.
+  bool isNeverEnabled(unsigned DiagID) const {
+    if (DiagID < NeverEnabledKnown.size() && NeverEnabledKnown[DiagID])
+      return NeverEnabled[DiagID];
+    return computeNeverEnabled(DiagID);
+  }
+  bool computeNeverEnabled(unsigned DiagID) const;
+
+  /// \brief Forget which diagnostics are never enabled.
+  void invalidateNeverEnabled() { NeverEnabledKnown.reset(); }
+
   /// \brief Finds the DiagStatePoint that contains the diagnostic state of
   /// the given source location.
   DiagState *GetDiagStateForLoc(SourceLocation Loc) const {
@@ -513,6 +541,7 @@ public:
   /// If this and IgnoreAllWarnings are both set, then that one wins.
   void setEnableAllWarnings(bool Val) {
     GetCurDiagState()->EnableAllWarnings = Val;
+    invalidateNeverEnabled();
   }
   bool getEnableAllWarnings() const {
     return GetCurDiagState()->EnableAllWarnings;
@@ -597,6 +626,7 @@ public:
   /// This corresponds to the GCC -pedantic and -pedantic-errors option.
   void setExtensionHandlingBehavior(diag::Severity H) {
     GetCurDiagState()->ExtBehavior = H;
+    invalidateNeverEnabled();
   }
   diag::Severity getExtensionHandlingBehavior() const {
     return GetCurDiagState()->ExtBehavior;
@@ -730,6 +760,9 @@ public:
   /// \param Loc The source location we are interested in finding out the
   /// diagnostic state. Can be null in order to query the latest state.
   bool isIgnored(unsigned DiagID, SourceLocation Loc) const {
+    // Warnings that are disabled everywhere need no state lookup.
+    if (isNeverEnabled(DiagID))
+      return true;
     return Diags->getDiagnosticSeverity(DiagID, Loc, *this) ==
            diag::Severity::Ignored;
   }
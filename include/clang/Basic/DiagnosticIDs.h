@@ -295,6 +295,12 @@ private:
   getDiagnosticSeverity(unsigned DiagID, SourceLocation Loc,
                         const DiagnosticsEngine &Diag) const LLVM_READONLY;
 
+  /// \brief Determine whether the builtin warning or extension \p DiagID is
+  /// mapped to be ignored in every diagnostic state of \p Diag, so that it is
+  /// ignored wherever it is reported.
+  bool isIgnoredInEveryState(unsigned DiagID,
+                             const DiagnosticsEngine &Diag) const;
+
   /// \brief Used to report a diagnostic that is finally fully formed.
   ///
   /// \returns \c true if the diagnostic was emitted, \c false if it was
@@ -218,6 +218,15 @@ public:
   const FileEntry *getFile(StringRef Filename, bool OpenFile = false,
                            bool CacheFailure = true);
 
+  /// \brief Returns true if a previous lookup, or a call to getVirtualFile(),
+  /// resolved \p Filename to a file. The file system is not accessed.
+  bool isKnownFile(StringRef Filename) const;
+
+  /// \brief Returns true if a previous lookup, or a call to getVirtualFile()
+  /// for a file inside it, resolved \p DirName to a directory. The file
+  /// system is not accessed.
+  bool isKnownDirectory(StringRef DirName) const;
+
   /// \brief Returns the current file system options
   FileSystemOptions &getFileSystemOpts() { return FileSystemOpts; }
   const FileSystemOptions &getFileSystemOpts() const { return FileSystemOpts; }
@@ -235,9 +244,16 @@ public:
 
   /// \brief Open the specified file as a MemoryBuffer, returning a new
   /// MemoryBuffer if successful, otherwise returning null.
+  ///
+  /// Large files are memory-mapped either way, unless a null terminator is
+  /// required and the file size is a multiple of the page size, leaving no
+  /// room for it in the mapping. Clients that do not need the buffer to be
+  /// null-terminated can pass \p RequiresNullTerminator = false so that
+  /// those files are mapped too.
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
   getBufferForFile(const FileEntry *Entry, bool isVolatile = false,
-                   bool ShouldCloseOpenFile = true);
+                   bool ShouldCloseOpenFile = true,
+                   bool RequiresNullTerminator = true);
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
   getBufferForFile(StringRef Filename);
 
@@ -126,6 +126,35 @@ public:
                        vfs::FileSystem &FS) override;
 };
 
+/// \brief A stat cache answering queries for a set of paths that were
+/// stat'ed ahead of time, possibly in parallel.
+///
+/// This is used to validate the many input files of an AST file with a
+/// single batch of concurrent stat calls, which matters on file systems
+/// with high latency. Queries for other paths, and queries that need to
+/// open the file, are passed down the chain.
+class PrefetchedStatCache : public FileSystemStatCache {
+  /// \brief The prefetched results; failed stats are recorded with a
+  /// \c CacheMissing result.
+  llvm::StringMap<std::pair<LookupResult, FileData>> Results;
+
+public:
+  /// \brief Stat each of \p Paths through \p FS, using up to \p NumThreads
+  /// threads.
+  ///
+  /// Only the real file system is known to be safe to query concurrently;
+  /// the paths are stat'ed one at a time through any other \p FS.
+  void prefetch(ArrayRef<std::string> Paths, vfs::FileSystem &FS,
+                unsigned NumThreads);
+
+  /// \brief The number of paths that were prefetched.
+  unsigned size() const { return Results.size(); }
+
+  LookupResult getStat(StringRef Path, FileData &Data, bool isFile,
+                       std::unique_ptr<vfs::File> *F,
+                       vfs::FileSystem &FS) override;
+};
+
 } // end namespace clang
 
 #endif
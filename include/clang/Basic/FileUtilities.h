@@ -0,0 +1,32 @@
+//===--- FileUtilities.h - Miscellaneous file utilities ---------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file declares helpers for writing files on disk.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_BASIC_FILEUTILITIES_H
+#define LLVM_CLANG_BASIC_FILEUTILITIES_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/StringRef.h"
+
+namespace clang {
+
+/// \brief Write \p Contents to \p Path through a temporary file in the same
+/// directory that is then renamed over \p Path, so that concurrent readers
+/// never observe a partially written file.
+///
+/// \returns true on error, in which case the temporary file is removed and
+/// \p Path is left untouched.
+bool writeFileAtomically(StringRef Path, StringRef Contents);
+
+} // end namespace clang
+
+#endif // LLVM_CLANG_BASIC_FILEUTILITIES_H
@@ -19,6 +19,7 @@
 #include "clang/Basic/LLVM.h"
 #include "clang/Basic/TokenKinds.h"
 #include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Allocator.h"
@@ -29,6 +30,7 @@
 #include <new>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace llvm {
 
@@ -449,6 +451,15 @@ public:
   /// be found.
   virtual IdentifierInfo* get(StringRef Name) = 0;
 
+  /// \brief Return the IdentifierInfo for the specified named identifier,
+  /// given its hash as computed by \c IdentifierTable::hash().
+  ///
+  /// Lookup sources that hash names the same way override this to avoid
+  /// hashing the name again.
+  virtual IdentifierInfo *getWithHash(StringRef Name, unsigned NameHash) {
+    return get(Name);
+  }
+
   /// \brief Retrieve an iterator into the set of all identifiers
   /// known to this identifier lookup source.
   ///
@@ -473,8 +484,35 @@ class IdentifierTable {
   typedef llvm::StringMap<IdentifierInfo*, llvm::BumpPtrAllocator> HashTableTy;
   HashTableTy HashTable;
 
+  /// \brief An identifier recently looked up by getWithHash().
+  struct RecentIdentifier {
+    unsigned Hash;
+    HashTableTy::MapEntryTy *Entry;
+  };
+
+  enum { NumRecentIdentifiers = 256 };
+
+  /// \brief A direct-mapped cache of the identifiers recently looked up by
+  /// getWithHash(), indexed by the low bits of their hash.
+  ///
+  /// Most identifier occurrences are of a few names, which are then found
+  /// with a single probe of this array, rather than by hashing the name again
+  /// and probing the bucket and hash arrays of the much larger \c HashTable.
+  /// It is kept to 4 KiB, so that it stays in the L1 cache.
+  RecentIdentifier RecentIdentifiers[NumRecentIdentifiers] = {};
+
   IdentifierInfoLookup* ExternalLookup;
 
+  /// \brief Whether the names added to the table are recorded in
+  /// \c AddedNames.
+  bool RecordAddedNames = false;
+  std::vector<StringRef> AddedNames;
+
+  void noteAddedName(const HashTableTy::MapEntryTy &Entry) {
+    if (RecordAddedNames)
+      AddedNames.push_back(Entry.getKey());
+  }
+
 public:
   /// \brief Create the identifier table, populating it with info about the
   /// language keywords for the language specified by \p LangOpts.
@@ -502,6 +540,7 @@ public:
 
     IdentifierInfo *&II = Entry.second;
     if (II) return *II;
+    noteAddedName(Entry);
 
     // No entry; if we have an external lookup, look there first.
     if (ExternalLookup) {
@@ -521,6 +560,58 @@ public:
     return *II;
   }
 
+  /// \brief Return the identifier token info for the specified named
+  /// identifier, given its hash as computed by hash().
+  ///
+  /// This is equivalent to get(Name), but avoids hashing the name again,
+  /// which callers such as the lexer can compute as they scan it.
+  IdentifierInfo &getWithHash(StringRef Name, unsigned NameHash) {
+    assert(NameHash == hash(Name) && "Wrong identifier hash!");
+    RecentIdentifier &Recent =
+        RecentIdentifiers[NameHash & (NumRecentIdentifiers - 1)];
+    if (Recent.Entry && Recent.Hash == NameHash &&
+        Recent.Entry->getKey() == Name)
+      return *Recent.Entry->second;
+
+    auto &Entry = *HashTable.insert(std::make_pair(Name, nullptr)).first;
+    Recent.Hash = NameHash;
+    Recent.Entry = &Entry;
+
+    IdentifierInfo *&II = Entry.second;
+    if (II) return *II;
+    noteAddedName(Entry);
+
+    // No entry; if we have an external lookup, look there first.
+    if (ExternalLookup) {
+      II = ExternalLookup->getWithHash(Name, NameHash);
+      if (II)
+        return *II;
+    }
+
+    // Lookups failed, make a new IdentifierInfo.
+    void *Mem = getAllocator().Allocate<IdentifierInfo>();
+    II = new (Mem) IdentifierInfo();
+
+    // Make sure getName() knows how to find the IdentifierInfo
+    // contents.
+    II->Entry = &Entry;
+
+    return *II;
+  }
+
+  /// \brief Compute the hash of an identifier name, as expected by
+  /// getWithHash().
+  ///
+  /// This is also the hash of the identifier tables of AST files, so a single
+  /// hash serves all the lookups of an identifier.
+  static unsigned hash(StringRef Name) { return llvm::HashString(Name); }
+
+  /// \brief Extend \p Hash, the hash() of a prefix of an identifier name,
+  /// with the next character \p C of the name.
+  static unsigned extendHash(unsigned Hash, unsigned char C) {
+    return Hash * 33 + C;
+  }
+
   IdentifierInfo &get(StringRef Name, tok::TokenKind TokenCode) {
     IdentifierInfo &II = get(Name);
     II.TokenID = TokenCode;
@@ -540,6 +631,7 @@ public:
     IdentifierInfo *&II = Entry.second;
     if (II)
       return *II;
+    noteAddedName(Entry);
 
     // Lookups failed, make a new IdentifierInfo.
     void *Mem = getAllocator().Allocate<IdentifierInfo>();
@@ -563,6 +655,20 @@ public:
   iterator end() const   { return HashTable.end(); }
   unsigned size() const  { return HashTable.size(); }
 
+  /// \brief Start recording the names added to the table from now on.
+  ///
+  /// This lets clients that keep data about all identifiers, such as the
+  /// typo correction index, catch up with the table without walking it.
+  void startRecordingAddedNames() { RecordAddedNames = true; }
+
+  /// \brief Retrieve the names added to the table since recording started or
+  /// since this was last called, in the order they were added.
+  std::vector<StringRef> takeAddedNames() {
+    std::vector<StringRef> Result;
+    Result.swap(AddedNames);
+    return Result;
+  }
+
   /// \brief Print some statistics to stderr that indicate how well the
   /// hashing is doing.
   void PrintStats() const;
@@ -53,6 +53,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <string>
@@ -398,11 +399,19 @@ namespace SrcMgr {
   ///
   /// SourceManager keeps an array of these objects, and they are uniquely
   /// identified by the FileID datatype.
+  ///
+  /// Macro expansions outnumber files by orders of magnitude, so the FileInfo
+  /// of a file entry is allocated separately by the SourceManager and only
+  /// referenced from here. This keeps an entry as small as an ExpansionInfo
+  /// plus its offset, instead of paying for the larger FileInfo in every
+  /// expansion entry.
   class SLocEntry {
     unsigned Offset : 31;
     unsigned IsExpansion : 1;
     union {
-      FileInfo File;
+      /// A \c const \c FileInfo*, stored as bytes so that the union only
+      /// needs the alignment of \c ExpansionInfo.
+      char File[sizeof(const FileInfo *)];
       ExpansionInfo Expansion;
     };
 
@@ -414,7 +423,9 @@ namespace SrcMgr {
 
     const FileInfo &getFile() const {
       assert(isFile() && "Not a file SLocEntry!");
-      return File;
+      const FileInfo *FI;
+      memcpy(&FI, File, sizeof(FI));
+      return *FI;
     }
 
     const ExpansionInfo &getExpansion() const {
@@ -422,12 +433,14 @@ namespace SrcMgr {
       return Expansion;
     }
 
-    static SLocEntry get(unsigned Offset, const FileInfo &FI) {
+    /// \brief Return a file entry referring to \p FI, which must outlive
+    /// the entry.
+    static SLocEntry get(unsigned Offset, const FileInfo *FI) {
       assert(!(Offset & (1 << 31)) && "Offset is too large");
       SLocEntry E;
       E.Offset = Offset;
       E.IsExpansion = false;
-      E.File = FI;
+      memcpy(E.File, &FI, sizeof(FI));
       return E;
     }
 
@@ -648,6 +661,34 @@ class SourceManager : public RefCountedBase<SourceManager> {
   /// is very common to look up many tokens from the same file.
   mutable FileID LastFileIDLookup;
 
+  /// \brief log2 of the size of the pages of the local source location
+  /// address space indexed by \c LocalSLocPageIndex.
+  static const unsigned SLocPageShift = 10;
+
+  /// \brief For each page of the local source location address space, the
+  /// index of the local SLocEntry that contains the first offset of the page.
+  ///
+  /// This bounds the search for the FileID of a local offset to the entries
+  /// that start within its page. The index is extended lazily, since the
+  /// entries of a page never change once it is below \c NextLocalOffset.
+  mutable std::vector<unsigned> LocalSLocPageIndex;
+
+  /// \brief A block of loaded SLocEntries allocated by one call to
+  /// \c AllocateLoadedSLocEntries(), i.e. by one module or PCH.
+  struct LoadedSLocAllocation {
+    /// The index into \c LoadedSLocEntryTable of the first entry.
+    unsigned BaseIndex;
+    /// The lowest offset of the block.
+    unsigned BaseOffset;
+  };
+
+  /// \brief The allocations of loaded SLocEntries, ordered by increasing
+  /// \c BaseIndex and hence decreasing \c BaseOffset.
+  ///
+  /// The search for the FileID of a loaded offset is confined to the block
+  /// containing it, so that it only deserializes entries of that block.
+  std::vector<LoadedSLocAllocation> LoadedSLocAllocations;
+
   /// \brief Holds information for \#line directives.
   ///
   /// This is referenced by indices from SLocEntryTable.
@@ -667,7 +708,7 @@ class SourceManager : public RefCountedBase<SourceManager> {
   FileID PreambleFileID;
 
   // Statistics for -print-stats.
-  mutable unsigned NumLinearScans, NumBinaryProbes;
+  mutable unsigned NumLinearScans, NumBinaryProbes, NumPageLookups;
 
   /// \brief Associates a FileID with its "included/expanded in" decomposed
   /// location.
@@ -1601,6 +1642,11 @@ private:
   llvm::MemoryBuffer *getFakeBufferForRecovery() const;
   const SrcMgr::ContentCache *getFakeContentCacheForRecovery() const;
 
+  /// \brief Allocate the FileInfo of a new file SLocEntry.
+  const SrcMgr::FileInfo *
+  createFileInfo(SourceLocation IncludePos, const SrcMgr::ContentCache *File,
+                 SrcMgr::CharacteristicKind FileCharacter) const;
+
   const SrcMgr::SLocEntry &loadSLocEntry(unsigned Index, bool *Invalid) const;
 
   /// \brief Get the entry with the given unwrapped FileID.
@@ -1673,6 +1719,7 @@ private:
   FileID getFileIDSlow(unsigned SLocOffset) const;
   FileID getFileIDLocal(unsigned SLocOffset) const;
   FileID getFileIDLoaded(unsigned SLocOffset) const;
+  void updateLocalSLocPageIndex() const;
 
   SourceLocation getExpansionLocSlowCase(SourceLocation Loc) const;
   SourceLocation getSpellingLocSlowCase(SourceLocation Loc) const;
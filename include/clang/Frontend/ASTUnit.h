@@ -868,6 +868,9 @@ public:
   /// for it to be loaded correctly, VFS should have access to it(i.e., be an
   /// overlay over RealFileSystem). RealFileSystem will be used if \p VFS is nullptr.
   ///
+  /// \param ParseDeclarationsOnly - Whether only declarations should be
+  /// analyzed, as in \c FrontendOptions::ParseDeclarationsOnly.
+  ///
   // FIXME: Move OnlyLocalDecls, UseBumpAllocator to setters on the ASTUnit, we
   // shouldn't need to specify them at construction time.
   static ASTUnit *LoadFromCommandLine(
@@ -886,7 +889,8 @@ public:
       bool UserFilesAreVolatile = false, bool ForSerialization = false,
       llvm::Optional<StringRef> ModuleFormat = llvm::None,
       std::unique_ptr<ASTUnit> *ErrAST = nullptr,
-      IntrusiveRefCntPtr<vfs::FileSystem> VFS = nullptr);
+      IntrusiveRefCntPtr<vfs::FileSystem> VFS = nullptr,
+      bool ParseDeclarationsOnly = false);
 
   /// \brief Reparse the source files using the same command-line options that
   /// were originally used to produce this translation unit.
@@ -27,6 +27,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace llvm {
 class raw_fd_ostream;
@@ -183,6 +184,10 @@ class CompilerInstance : public ModuleLoader {
   /// The list of active output files.
   std::list<OutputFile> OutputFiles;
 
+  /// \brief The memory breakdowns of the translation units processed so far,
+  /// each as a JSON object, to be written to the -memory-stats-file.
+  std::vector<std::string> MemoryStats;
+
   CompilerInstance(const CompilerInstance &) = delete;
   void operator=(const CompilerInstance &) = delete;
 public:
@@ -596,6 +601,12 @@ public:
   /// \param EraseFiles - If true, attempt to erase the files from disk.
   void clearOutputFiles(bool EraseFiles);
 
+  /// \brief Add the memory breakdown of a translation unit, as a JSON object,
+  /// to those written to the -memory-stats-file once all inputs are processed.
+  void addMemoryStats(std::string Stats) {
+    MemoryStats.push_back(std::move(Stats));
+  }
+
   /// }
   /// @name Construction Utility Methods
   /// {
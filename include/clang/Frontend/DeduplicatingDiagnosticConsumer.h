@@ -0,0 +1,102 @@
+//===--- DeduplicatingDiagnosticConsumer.h - Drop repeats -------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_FRONTEND_DEDUPLICATINGDIAGNOSTICCONSUMER_H
+#define LLVM_CLANG_FRONTEND_DEDUPLICATINGDIAGNOSTICCONSUMER_H
+
+#include "clang/Basic/Diagnostic.h"
+#include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/ADT/StringSet.h"
+#include <memory>
+#include <mutex>
+
+namespace clang {
+class LangOptions;
+
+/// \brief The set of diagnostics already reported by the
+/// DeduplicatingDiagnosticConsumers sharing it.
+///
+/// A tool processing many translation units in one process shares a single
+/// set among all of them, so that a warning in a header is reported once
+/// rather than once per translation unit including it, as
+/// \c tooling::ClangTool::setDeduplicateDiagnostics() does. The set can be
+/// used from several threads.
+class DiagnosticDeduplicationSet
+    : public llvm::ThreadSafeRefCountedBase<DiagnosticDeduplicationSet> {
+  std::mutex Mutex;
+  llvm::StringSet<> Seen;
+  unsigned NumDuplicates = 0;
+
+public:
+  /// \brief Record the diagnostic identified by \p Key.
+  ///
+  /// \returns true if it had not been reported before.
+  bool insert(StringRef Key);
+
+  /// \brief The number of distinct diagnostics reported.
+  unsigned getNumUnique();
+
+  /// \brief The number of diagnostics dropped as duplicates.
+  unsigned getNumDuplicates();
+};
+
+/// \brief A diagnostic consumer that forwards each diagnostic to another
+/// consumer only the first time it is seen.
+///
+/// Diagnostics are identified by their ID, level, location and arguments,
+/// not by their text: a repeated diagnostic is dropped before it is
+/// formatted or rendered, and so are the notes attached to it. Pairing this
+/// with \c serialized_diags::create() yields a single compact, deduplicated
+/// diagnostics file for a whole multi-TU tool run; the serialized diagnostics
+/// writer still formats the message of each diagnostic that gets through.
+class DeduplicatingDiagnosticConsumer : public DiagnosticConsumer {
+  std::unique_ptr<DiagnosticConsumer> OwningTarget;
+  DiagnosticConsumer *Target;
+  IntrusiveRefCntPtr<DiagnosticDeduplicationSet> Seen;
+
+  /// Whether the last non-note diagnostic was dropped, in which case its
+  /// notes are dropped too.
+  bool DroppingNotes = false;
+
+  /// Scratch buffer for building diagnostic keys.
+  SmallString<128> Key;
+
+public:
+  /// \param Seen the set of diagnostics already reported, shared with other
+  /// consumers; a fresh set is used if null.
+  DeduplicatingDiagnosticConsumer(
+      std::unique_ptr<DiagnosticConsumer> Target,
+      IntrusiveRefCntPtr<DiagnosticDeduplicationSet> Seen = nullptr);
+  /// \brief Forward diagnostics to \p Target, which is not owned.
+  DeduplicatingDiagnosticConsumer(
+      DiagnosticConsumer *Target,
+      IntrusiveRefCntPtr<DiagnosticDeduplicationSet> Seen = nullptr);
+  ~DeduplicatingDiagnosticConsumer() override;
+
+  DiagnosticDeduplicationSet &getDeduplicationSet() { return *Seen; }
+
+  void BeginSourceFile(const LangOptions &LO, const Preprocessor *PP) override {
+    Target->BeginSourceFile(LO, PP);
+  }
+
+  void EndSourceFile() override { Target->EndSourceFile(); }
+
+  void finish() override { Target->finish(); }
+
+  bool IncludeInDiagnosticCounts() const override {
+    return Target->IncludeInDiagnosticCounts();
+  }
+
+  void HandleDiagnostic(DiagnosticsEngine::Level DiagLevel,
+                        const Diagnostic &Info) override;
+};
+
+} // end namespace clang
+
+#endif
@@ -133,6 +133,15 @@ public:
   bool hasCodeCompletionSupport() const override { return true; }
 };
 
+/// \brief Parse and analyze only the declarations of the input, skipping all
+/// function bodies that are not needed to do so.
+///
+/// This is meant for tools that summarize the interface of headers.
+class ParseDeclarationsOnlyAction : public SyntaxOnlyAction {
+protected:
+  bool BeginInvocation(CompilerInstance &CI) override;
+};
+
 /// \brief Dump information about the given module file, to be used for
 /// basic debugging and discovery.
 class DumpModuleInfoAction : public ASTFrontendAction {
@@ -50,6 +50,7 @@ namespace frontend {
     ModuleFileInfo,         ///< Dump information about a module file.
     VerifyPCH,              ///< Load and verify that a PCH file is usable.
     ParseSyntaxOnly,        ///< Parse and perform semantic analysis.
+    ParseDeclarationsOnly,  ///< Parse and analyze declarations only.
     PluginAction,           ///< Run a plugin action, \see ActionName.
     PrintDeclContext,       ///< Print DeclContext and their Decls.
     PrintPreamble,          ///< Print the "preamble" of the input file
@@ -186,6 +187,10 @@ public:
                                            /// speed up parsing in cases you do
                                            /// not need them (e.g. with code
                                            /// completion).
+  unsigned ParseDeclarationsOnly : 1;      ///< Only analyze declarations,
+                                           /// skipping every function body
+                                           /// and implicit definition they
+                                           /// do not depend on.
   unsigned UseGlobalModuleIndex : 1;       ///< Whether we can use the
                                            ///< global module index if available.
   unsigned GenerateGlobalModuleIndex : 1;  ///< Whether we can generate the
@@ -202,6 +207,9 @@ public:
                                            ///< files into the PCM file.
   unsigned IncludeTimestamps : 1;          ///< Whether timestamps should be
                                            ///< written to the produced PCH file.
+  unsigned CompressASTLookupTables : 1;    ///< Whether name lookup tables
+                                           ///< are compressed in the produced
+                                           ///< PCH file.
 
   CodeCompleteOptions CodeCompleteOpts;
 
@@ -324,16 +332,21 @@ public:
   /// Filename to write statistics to.
   std::string StatsFile;
 
+  /// Filename to write the memory breakdown of each translation unit to.
+  std::string MemoryStatsFile;
+
 public:
   FrontendOptions() :
     DisableFree(false), RelocatablePCH(false), ShowHelp(false),
     ShowStats(false), ShowTimers(false), ShowVersion(false),
     FixWhatYouCan(false), FixOnlyWarnings(false), FixAndRecompile(false),
     FixToTemporaries(false), ARCMTMigrateEmitARCErrors(false),
-    SkipFunctionBodies(false), UseGlobalModuleIndex(true),
-    GenerateGlobalModuleIndex(true), ASTDumpDecls(false), ASTDumpLookups(false),
+    SkipFunctionBodies(false), ParseDeclarationsOnly(false),
+    UseGlobalModuleIndex(true), GenerateGlobalModuleIndex(true),
+    ASTDumpDecls(false), ASTDumpLookups(false),
     BuildingImplicitModule(false), ModulesEmbedAllFiles(false),
-    IncludeTimestamps(true), ARCMTAction(ARCMT_None),
+    IncludeTimestamps(true), CompressASTLookupTables(false),
+    ARCMTAction(ARCMT_None),
     ObjCMTAction(ObjCMT_None), ProgramAction(frontend::ParseSyntaxOnly)
   {}
 
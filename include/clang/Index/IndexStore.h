@@ -0,0 +1,141 @@
+//===--- IndexStore.h - Persistent on-disk index store ----------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// The index store keeps the symbol occurrences produced by the indexer on
+// disk so that clients can answer find-references/definitions queries
+// without parsing. It has the following layout:
+//
+//   <store>/v2/units/<unit-name>      one unit file per translation unit,
+//                                     listing the files it depends on.
+//   <store>/v2/records/<record-name>  one record file per source file,
+//                                     holding its occurrences keyed by USR.
+//
+// Record names are derived from the path, size and modification time of the
+// source file, so a file that did not change since it was last indexed maps
+// to an existing record and is skipped on reindex. A translation unit none
+// of whose files changed need not be parsed at all, see
+// IndexStoreReader::isUnitUpToDate().
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_INDEX_INDEXSTORE_H
+#define LLVM_CLANG_INDEX_INDEXSTORE_H
+
+#include "clang/Basic/LLVM.h"
+#include "clang/Index/IndexSymbol.h"
+#include "clang/Index/IndexingAction.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include <memory>
+#include <string>
+
+namespace clang {
+  class FrontendAction;
+
+namespace index {
+
+/// \brief Create a frontend action that indexes the translation unit and
+/// writes the resulting records and unit file into the store at
+/// \p StorePath, creating the store if needed.
+///
+/// \param WrappedAction another frontend action to wrap over or null.
+std::unique_ptr<FrontendAction>
+createIndexStoreAction(StringRef StorePath, IndexingOptions Opts,
+                       std::unique_ptr<FrontendAction> WrappedAction);
+
+/// \brief A file that a unit depends on.
+struct StoreUnitDependency {
+  StringRef FilePath;
+  /// The record holding the occurrences of the file, or empty if the file
+  /// contributed no occurrences.
+  StringRef RecordName;
+  uint64_t Size;
+  uint64_t ModTime;
+};
+
+/// \brief A symbol occurrence read back from the store.
+struct StoreOccurrence {
+  StringRef USR;
+  StringRef FilePath;
+  SymbolKind Kind;
+  SymbolRoleSet Roles;
+  unsigned Line;
+  unsigned Column;
+};
+
+/// \brief Provides read-only access to an index store written by the action
+/// returned by \c createIndexStoreAction().
+///
+/// Record files are memory-mapped on first use and queried through their
+/// on-disk hash tables, so lookups do not need to parse any source.
+class IndexStoreReader {
+  class RecordFile;
+
+  std::string StorePath;
+  llvm::StringMap<std::unique_ptr<RecordFile>> Records;
+
+  explicit IndexStoreReader(StringRef StorePath);
+
+  RecordFile *getRecord(StringRef RecordName);
+
+public:
+  ~IndexStoreReader();
+
+  /// \brief Open the store at \p StorePath.
+  ///
+  /// \returns the reader, or null with \p Error set if the path does not
+  /// contain a store of a supported version.
+  static std::unique_ptr<IndexStoreReader> open(StringRef StorePath,
+                                                std::string &Error);
+
+  /// \brief Invoke \p Receiver with the name of each unit in the store.
+  ///
+  /// \returns false if the receiver aborted the walk, true otherwise.
+  bool foreachUnit(llvm::function_ref<bool(StringRef UnitName)> Receiver);
+
+  /// \brief Invoke \p Receiver with each dependency of the unit \p UnitName.
+  ///
+  /// \returns false if the unit could not be read or the receiver aborted the
+  /// walk, true otherwise.
+  bool foreachUnitDependency(
+      StringRef UnitName,
+      llvm::function_ref<bool(const StoreUnitDependency &)> Receiver);
+
+  /// \brief Determine whether the store has an up-to-date unit for the
+  /// translation unit whose main file is \p MainFilePath, so that it does not
+  /// need to be indexed again.
+  ///
+  /// The unit is up-to-date if every file it depends on still has the size
+  /// and modification time recorded in the unit, and the records of those
+  /// files are in the store. Changes of the compiler options are not
+  /// detected.
+  bool isUnitUpToDate(StringRef MainFilePath);
+
+  /// \brief Invoke \p Receiver with each occurrence of \p USR whose roles
+  /// intersect \p RoleFilter, across all records referenced by the units in
+  /// the store. A zero \p RoleFilter matches every occurrence.
+  ///
+  /// \returns false if the receiver aborted the walk, true otherwise.
+  bool foreachOccurrenceOfUSR(
+      StringRef USR, SymbolRoleSet RoleFilter,
+      llvm::function_ref<bool(const StoreOccurrence &)> Receiver);
+
+  /// \brief Invoke \p Receiver with each definition of \p USR.
+  bool foreachDefinitionOfUSR(
+      StringRef USR,
+      llvm::function_ref<bool(const StoreOccurrence &)> Receiver) {
+    return foreachOccurrenceOfUSR(
+        USR, (SymbolRoleSet)SymbolRole::Definition, Receiver);
+  }
+};
+
+} // namespace index
+} // namespace clang
+
+#endif
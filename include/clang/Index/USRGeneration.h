@@ -11,7 +11,10 @@
 #define LLVM_CLANG_INDEX_USRGENERATION_H
 
 #include "clang/Basic/LLVM.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/Allocator.h"
 
 namespace clang {
 class Decl;
@@ -29,6 +32,56 @@ static inline StringRef getUSRSpacePrefix() {
 /// \returns true if the results should be ignored, false otherwise.
 bool generateUSRForDecl(const Decl *D, SmallVectorImpl<char> &Buf);
 
+/// \brief Generate a USR for a Decl, including the USR prefix, writing it
+/// to \p OS.
+/// \returns true if the results should be ignored, false otherwise.
+bool generateUSRForDecl(const Decl *D, raw_ostream &OS);
+
+/// \brief A 128-bit identifier of a USR. \c Low alone can serve as a 64-bit
+/// identifier.
+struct USRHash {
+  uint64_t Low = 0;
+  uint64_t High = 0;
+
+  bool operator==(const USRHash &RHS) const {
+    return Low == RHS.Low && High == RHS.High;
+  }
+  bool operator!=(const USRHash &RHS) const { return !(*this == RHS); }
+};
+
+/// \brief Compute the identifier of a USR string.
+USRHash hashUSR(StringRef USR);
+
+/// \brief Compute the identifier of the USR of a Decl without materializing
+/// the USR string. The result is equal to \c hashUSR() of the USR.
+/// \returns true if the results should be ignored, false otherwise.
+bool generateUSRHashForDecl(const Decl *D, USRHash &Hash);
+
+/// \brief Memoizes the USRs of the declarations of a single ASTContext.
+///
+/// Indexers request the USR of the same declaration for each of its
+/// occurrences; the cache generates it once and hands out an interned copy.
+/// The cache must be cleared when the ASTContext it was used with goes away.
+class USRCache {
+  /// The USR of each Decl seen so far, or an empty string if its USR should
+  /// be ignored.
+  llvm::DenseMap<const Decl *, StringRef> USRs;
+  llvm::DenseMap<const Decl *, USRHash> Hashes;
+  llvm::StringSet<llvm::BumpPtrAllocator> Strings;
+
+public:
+  /// \brief Retrieve the USR of \p D, which stays valid until the cache is
+  /// cleared.
+  /// \returns true if the results should be ignored, false otherwise.
+  bool getUSR(const Decl *D, StringRef &USR);
+
+  /// \brief Retrieve the identifier of the USR of \p D.
+  /// \returns true if the results should be ignored, false otherwise.
+  bool getUSRHash(const Decl *D, USRHash &Hash);
+
+  void clear();
+};
+
 /// \brief Generate a USR fragment for an Objective-C class.
 void generateUSRForObjCClass(StringRef Cls, raw_ostream &OS,
                              StringRef ExtSymbolDefinedIn = "",
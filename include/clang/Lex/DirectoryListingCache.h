@@ -0,0 +1,133 @@
+//===--- DirectoryListingCache.h - Cached directory listings ----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the DirectoryListingCache interface, which lets header
+// search reject include lookups in search directories without touching the
+// file system.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LEX_DIRECTORYLISTINGCACHE_H
+#define LLVM_CLANG_LEX_DIRECTORYLISTINGCACHE_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/IntrusiveRefCntPtr.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/Chrono.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace llvm {
+class MemoryBuffer;
+}
+
+namespace clang {
+
+namespace vfs {
+class FileSystem;
+}
+
+/// \brief Caches the names of the entries of header search directories.
+///
+/// Each directory is read once and its entry names are kept sorted, so that
+/// header search can tell that an include cannot be satisfied by a directory
+/// (or that a framework does not exist in a framework directory) without a
+/// failing stat. Listings are keyed by directory path alone, so a cache can
+/// only be shared by translation units that see the same file system; header
+/// search therefore uses it only when reading the real file system. Listings
+/// are re-read when the modification time of their directory changes.
+/// Listings of directories modified no earlier than the second they were read
+/// in are not cached, since a later change within that second may not update
+/// the modification time.
+///
+/// The cache can also be saved to a file and memory-mapped by later compiler
+/// invocations, which then only need to stat each directory to validate its
+/// listing instead of reading it again.
+///
+/// Names are compared case-insensitively, so that a lookup is never wrongly
+/// rejected on a case-insensitive file system.
+class DirectoryListingCache
+    : public llvm::ThreadSafeRefCountedBase<DirectoryListingCache> {
+public:
+  /// \brief The entry names of one directory at a point in time.
+  class Listing {
+    llvm::sys::TimePoint<> ModTime;
+    /// When the directory was read.
+    llvm::sys::TimePoint<> ReadTime;
+    /// The lowercased entry names, sorted. They point either into
+    /// \c NameStorage or into the cache file this listing was loaded from.
+    std::vector<StringRef> Names;
+    llvm::BumpPtrAllocator NameStorage;
+    std::shared_ptr<llvm::MemoryBuffer> CacheFile;
+
+    friend class DirectoryListingCache;
+
+  public:
+    /// \brief Whether the directory contains an entry named \p Name.
+    bool contains(StringRef Name) const;
+  };
+
+private:
+  class CacheFileTable;
+
+  std::mutex Mutex;
+  llvm::StringMap<std::shared_ptr<const Listing>> Listings;
+
+  /// The cache file loaded by \c loadFromFile(), if any.
+  std::string LoadedPath;
+  std::shared_ptr<llvm::MemoryBuffer> LoadedBuffer;
+  /// The on-disk hash table of \c LoadedBuffer, mapping directory paths to
+  /// listings.
+  std::unique_ptr<CacheFileTable> LoadedTable;
+
+  /// Whether listings were read since the cache was loaded or last saved.
+  bool Dirty = false;
+
+  /// \brief Look up \p DirPath in the loaded cache file. Must be called with
+  /// \c Mutex held.
+  std::shared_ptr<const Listing> getLoadedListing(StringRef DirPath);
+
+public:
+  DirectoryListingCache();
+  ~DirectoryListingCache();
+
+  /// \brief Retrieve the up-to-date listing of the directory \p DirPath,
+  /// reading it from \p FS if it was not cached or has been modified.
+  /// \p DirPath should be absolute, since the cache may be shared by
+  /// compilations with different working directories.
+  ///
+  /// \returns the listing, or null if the directory could not be read, in
+  /// which case lookups must fall back to the file system.
+  std::shared_ptr<const Listing> getListing(vfs::FileSystem &FS,
+                                            StringRef DirPath);
+
+  /// \brief Memory-map the listings saved in the cache file \p Path, which
+  /// are then used for directories not read by this cache yet. Loading the
+  /// same file again has no effect.
+  ///
+  /// \returns true if the file could not be loaded.
+  bool loadFromFile(StringRef Path);
+
+  /// \brief Save all listings to the cache file \p Path if any were read
+  /// since the cache was loaded. The file is replaced atomically, so
+  /// concurrent compilations can share it.
+  ///
+  /// \returns true if the file could not be written.
+  bool writeToFile(StringRef Path);
+
+  /// \brief Retrieve the cache shared by all header searches of the process.
+  static IntrusiveRefCntPtr<DirectoryListingCache> getProcessCache();
+};
+
+} // end namespace clang
+
+#endif
@@ -14,6 +14,7 @@
 #ifndef LLVM_CLANG_LEX_HEADERSEARCH_H
 #define LLVM_CLANG_LEX_HEADERSEARCH_H
 
+#include "clang/Lex/DirectoryListingCache.h"
 #include "clang/Lex/DirectoryLookup.h"
 #include "clang/Lex/ModuleMap.h"
 #include "llvm/ADT/ArrayRef.h"
@@ -199,6 +200,19 @@ class HeaderSearch {
   };
   llvm::StringMap<LookupFileCacheInfo, llvm::BumpPtrAllocator> LookupFileCache;
 
+  /// \brief Listings of the search directories, used to reject lookups in
+  /// directories that cannot contain the requested file without touching the
+  /// file system. Null unless enabled.
+  IntrusiveRefCntPtr<DirectoryListingCache> ListingCache;
+
+  /// \brief The listing of each directory consulted so far, keyed by path.
+  /// This covers search directories as well as framework directories and
+  /// the frameworks within them. Listings are validated against the file
+  /// system once per header search; a null listing means the directory
+  /// could not be listed.
+  llvm::StringMap<std::shared_ptr<const DirectoryListingCache::Listing>>
+      DirectoryListings;
+
   /// \brief Collection mapping a framework or subframework
   /// name like "Carbon" to the Carbon.framework directory.
   llvm::StringMap<FrameworkCacheEntry, llvm::BumpPtrAllocator> FrameworkMap;
@@ -240,6 +254,7 @@ class HeaderSearch {
   unsigned NumIncluded;
   unsigned NumMultiIncludeFileOptzn;
   unsigned NumFrameworkLookups, NumSubFrameworkLookups;
+  unsigned NumDirectoryListingRejections;
 
   // HeaderSearch doesn't support default or copy construction.
   HeaderSearch(const HeaderSearch&) = delete;
@@ -272,6 +287,15 @@ public:
     //LookupFileCache.clear();
   }
 
+  /// \brief Consult the directory listings in \p Cache before probing a
+  /// search directory for a header.
+  ///
+  /// The cache is keyed by path only, so it is ignored unless the file
+  /// manager reads the real file system; listings of an overlay or in-memory
+  /// file system must not leak into, or be answered from, a shared cache.
+  void
+  setDirectoryListingCache(IntrusiveRefCntPtr<DirectoryListingCache> Cache);
+
   /// \brief Add an additional search path.
   void AddSearchPath(const DirectoryLookup &dir, bool isAngled) {
     unsigned idx = isAngled ? SystemDirIdx : AngledDirIdx;
@@ -619,6 +643,14 @@ private:
                           Module *RequestingModule,
                           ModuleMap::KnownHeader *SuggestedModule);
 
+  /// \brief Determine whether the directory \p DirPath may contain
+  /// \p Filename, whose full path is \p Path, according to its cached
+  /// listing.
+  ///
+  /// \return \c false only if the file definitely cannot be found there.
+  bool mayDirectoryContain(StringRef DirPath, StringRef Filename,
+                           StringRef Path);
+
 public:
   /// \brief Retrieve the module map.
   ModuleMap &getModuleMap() { return ModMap; }
@@ -1601,7 +1601,18 @@ public:
   /// updating the token kind accordingly.
   IdentifierInfo *LookUpIdentifierInfo(Token &Identifier) const;
 
+  /// Given a tok::raw_identifier token that does not need cleaning and the
+  /// hash of its spelling, as computed by IdentifierTable::hash(), look up
+  /// the identifier information for the token and install it into the token,
+  /// updating the token kind accordingly.
+  IdentifierInfo *LookUpIdentifierInfo(Token &Identifier,
+                                       unsigned NameHash) const;
+
 private:
+  /// Install \p II into the identifier token \p Identifier, updating the
+  /// token kind accordingly.
+  void installIdentifierInfo(Token &Identifier, IdentifierInfo *II) const;
+
   llvm::DenseMap<IdentifierInfo*,unsigned> PoisonReasons;
 
 public:
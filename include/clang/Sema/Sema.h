@@ -131,6 +131,7 @@ namespace clang {
   class IntegerLiteral;
   class LabelStmt;
   class LambdaExpr;
+  class LazyMemberInstantiationSource;
   class LangOptions;
   class LocalInstantiationScope;
   class LookupResult;
@@ -182,6 +183,7 @@ namespace clang {
   class TypedefNameDecl;
   class TypeLoc;
   class TypoCorrectionConsumer;
+  class TypoCorrectionIndex;
   class UnqualifiedId;
   class UnresolvedLookupExpr;
   class UnresolvedMemberExpr;
@@ -312,6 +314,14 @@ public:
   /// \brief Flag indicating whether or not to collect detailed statistics.
   bool CollectStats;
 
+  /// \brief Whether only the declarations of the translation unit are of
+  /// interest.
+  ///
+  /// Function bodies are then skipped whenever they can be, and the function
+  /// definitions, vtables and implicit instantiations that are only needed
+  /// for code generation are never produced.
+  bool DeclarationsOnly;
+
   /// \brief Code-completion consumer.
   CodeCompleteConsumer *CodeCompleter;
 
@@ -1039,6 +1049,39 @@ public:
   /// for C++ records.
   llvm::FoldingSet<SpecialMemberOverloadResultEntry> SpecialMemberCache;
 
+  /// \brief The memoized, successful deduction of the template arguments of
+  /// a function template from the arguments of a call.
+  class DeducedCallCacheEntry : public llvm::FastFoldingSetNode {
+    FunctionDecl *Specialization;
+    ArrayRef<QualType> ParamTypesForArgChecking;
+
+  public:
+    DeducedCallCacheEntry(const llvm::FoldingSetNodeID &ID,
+                          FunctionDecl *Specialization,
+                          ArrayRef<QualType> ParamTypesForArgChecking)
+      : FastFoldingSetNode(ID), Specialization(Specialization),
+        ParamTypesForArgChecking(ParamTypesForArgChecking) {}
+
+    /// \brief The specialization produced by the deduction.
+    FunctionDecl *getSpecialization() const { return Specialization; }
+
+    /// \brief The parameter types that were passed to the check of the
+    /// conversions for non-dependent parameters.
+    ArrayRef<QualType> getParamTypesForArgChecking() const {
+      return ParamTypesForArgChecking;
+    }
+  };
+
+  /// \brief A cache of template argument deductions for calls to function
+  /// templates, keyed by the template and the canonical types and value
+  /// kinds of the call arguments.
+  llvm::FoldingSet<DeducedCallCacheEntry> DeducedCallCache;
+
+  /// \brief The number of call deductions satisfied by, and added to, the
+  /// DeducedCallCache.
+  unsigned NumDeducedCallCacheHits = 0;
+  unsigned NumDeducedCallCacheEntries = 0;
+
   /// \brief A cache of the flags available in enumerations with the flag_bits
   /// attribute.
   mutable llvm::DenseMap<const EnumDecl*, llvm::APInt> FlagBitsCache;
@@ -1057,6 +1100,18 @@ public:
   /// \brief The number of SFINAE diagnostics that have been trapped.
   unsigned NumSFINAEErrors;
 
+  /// \brief The number of overload resolutions performed.
+  unsigned NumOverloadResolutions;
+
+  /// \brief The number of candidates considered by overload resolution, and
+  /// how many of them were viable.
+  unsigned NumOverloadCandidates;
+  unsigned NumViableOverloadCandidates;
+
+  /// \brief The number of overload candidates rejected by the cheap check of
+  /// their first parameter, without computing a conversion sequence.
+  unsigned NumOverloadCandidatesPrefiltered;
+
   typedef llvm::DenseMap<ParmVarDecl *, llvm::TinyPtrVector<ParmVarDecl *>>
     UnparsedDefaultArgInstantiationsMap;
 
@@ -6952,6 +7007,11 @@ public:
       bool PartialOverloading = false,
       llvm::function_ref<bool()> CheckNonDependent = []{ return false; });
 
+  TemplateDeductionResult FinishCachedTemplateArgumentDeduction(
+      FunctionTemplateDecl *FunctionTemplate, DeducedCallCacheEntry &Entry,
+      FunctionDecl *&Specialization, sema::TemplateDeductionInfo &Info,
+      llvm::function_ref<bool(ArrayRef<QualType>)> CheckNonDependent);
+
   TemplateDeductionResult DeduceTemplateArguments(
       FunctionTemplateDecl *FunctionTemplate,
       TemplateArgumentListInfo *ExplicitTemplateArgs, ArrayRef<Expr *> Args,
@@ -7527,6 +7587,14 @@ public:
   /// \brief The number of typos corrected by CorrectTypo.
   unsigned TyposCorrected;
 
+  /// \brief The index of identifiers searched for typo correction
+  /// candidates, built on the first typo correction.
+  std::unique_ptr<TypoCorrectionIndex> TypoIndex;
+
+  /// \brief The time spent searching the identifiers of the translation unit
+  /// for typo correction candidates, in seconds.
+  double TypoCandidateSearchTime;
+
   typedef llvm::SmallSet<SourceLocation, 2> SrcLocSet;
   typedef llvm::DenseMap<IdentifierInfo *, SrcLocSet> IdentifierSourceLocations;
 
@@ -7553,6 +7621,11 @@ public:
   /// but have not yet been performed.
   std::deque<PendingImplicitInstantiation> PendingInstantiations;
 
+  /// \brief The external AST source that instantiates the declarations of
+  /// class template members on first lookup, if
+  /// -flazy-template-member-instantiation is in effect.
+  LazyMemberInstantiationSource *LazyMemberSource = nullptr;
+
   class GlobalEagerInstantiationScope {
   public:
     GlobalEagerInstantiationScope(Sema &S, bool Enabled)
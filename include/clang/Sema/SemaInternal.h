@@ -19,6 +19,9 @@
 #include "clang/Sema/Lookup.h"
 #include "clang/Sema/Sema.h"
 #include "clang/Sema/SemaDiagnostic.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/Allocator.h"
+#include <vector>
 
 namespace clang {
 
@@ -100,6 +103,64 @@ inline InheritableAttr *getDLLAttr(Decl *D) {
   return nullptr;
 }
 
+/// \brief An index of the identifiers known to a translation unit, used to
+/// find typo correction candidates without computing the edit distance
+/// between the typo and every identifier.
+///
+/// Identifiers are bucketed by length and carry a signature of the characters
+/// they contain. Both give cheap lower bounds on the edit distance to a typo,
+/// which reject most identifiers before the edit distance is computed. The
+/// index is brought up to date lazily: the identifier table is walked once,
+/// after which it records the names added to it, so that each update only
+/// indexes those. The identifiers of the external source are collected again
+/// when it has loaded more of them.
+class TypoCorrectionIndex {
+  struct IndexedName {
+    StringRef Name;
+    uint64_t Chars;
+  };
+  typedef std::vector<std::vector<IndexedName>> NamesByLength;
+
+  /// The identifiers of the identifier table.
+  NamesByLength LocalNames;
+  unsigned NumLocalNames = 0;
+  /// Whether the identifier table records the names added to it for us.
+  bool TracksLocalNames = false;
+
+  /// The identifiers of the external identifier source, which are copied
+  /// into \c ExternalNameStorage.
+  NamesByLength ExternalNames;
+  llvm::BumpPtrAllocator ExternalNameStorage;
+  unsigned NumExternalNames = 0;
+  /// The generation of the external AST source the external identifiers
+  /// were collected in.
+  uint32_t ExternalGeneration = 0;
+  bool HasExternalNames = false;
+
+  // Statistics.
+  unsigned NumSearches = 0;
+  unsigned NumNamesConsidered = 0;
+  unsigned NumNamesRejected = 0;
+
+  static uint64_t getCharSignature(StringRef Name);
+  static void addName(NamesByLength &Names, StringRef Name);
+  void search(const NamesByLength &Names, StringRef Typo,
+              llvm::function_ref<void(StringRef)> Found);
+
+public:
+  /// \brief Bring the index up to date with the identifiers of \p Context.
+  void update(ASTContext &Context);
+
+  /// \brief Pass each indexed identifier that may be close enough to \p Typo
+  /// to be accepted by \c TypoCorrectionConsumer::FoundName() to \p Found.
+  ///
+  /// Identifiers that are not passed are certain to be rejected.
+  void findCandidates(StringRef Typo,
+                      llvm::function_ref<void(StringRef)> Found);
+
+  void PrintStats() const;
+};
+
 class TypoCorrectionConsumer : public VisibleDeclConsumer {
   typedef SmallVector<TypoCorrection, 1> TypoResultList;
   typedef llvm::StringMap<TypoResultList> TypoResultsMap;
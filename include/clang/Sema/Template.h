@@ -14,7 +14,11 @@
 
 #include "clang/AST/DeclTemplate.h"
 #include "clang/AST/DeclVisitor.h"
+#include "clang/AST/ExternalASTSource.h"
 #include "clang/Sema/Sema.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
 #include <cassert>
 #include <utility>
@@ -564,6 +568,81 @@ namespace clang {
     Decl *instantiateUnresolvedUsingDecl(T *D,
                                          bool InstantiatingPackElement = false);
   };  
+
+  /// \brief Defers the instantiation of the declarations of class template
+  /// member functions until their name is first looked up in the class
+  /// template specialization.
+  ///
+  /// Used with -flazy-template-member-instantiation. It is installed as the
+  /// external AST source of the ASTContext, so that DeclContext::lookup()
+  /// asks it for the members of an instantiated class with a given name, and
+  /// can therefore only be used when there is no other external AST source.
+  /// Only members that nothing but name lookup can find are deferred:
+  /// non-virtual member functions and member function templates with plain
+  /// identifier names and no attributes, of classes without polymorphic
+  /// bases that are not dllexported. A name is deferred either for all of
+  /// its members or for none, so that a lookup never finds only part of an
+  /// overload set.
+  class LazyMemberInstantiationSource : public ExternalASTSource {
+    /// The Sema instantiating the members, or null once it is destroyed.
+    Sema *SemaRef;
+
+    /// The members of one class whose instantiation was deferred.
+    struct PendingMembers {
+      MultiLevelTemplateArgumentList TemplateArgs;
+      SourceLocation PointOfInstantiation;
+      SmallVector<NamedDecl *, 8> Members;
+    };
+    llvm::DenseMap<const CXXRecordDecl *, PendingMembers> Pending;
+
+    // Statistics.
+    unsigned NumMembersDeferred = 0;
+    unsigned NumMembersInstantiated = 0;
+
+    /// \brief Instantiate the pending members of \p Record that \p Filter
+    /// selects, and drop them from the pending list.
+    ///
+    /// \returns true if any member was instantiated.
+    bool instantiate(const CXXRecordDecl *Record,
+                     llvm::function_ref<bool(NamedDecl *)> Filter);
+
+  public:
+    explicit LazyMemberInstantiationSource(Sema &SemaRef)
+        : SemaRef(&SemaRef) {}
+
+    /// \brief Determine whether the members of \p Instantiation, whose bases
+    /// and attributes have been instantiated, can be deferred at all.
+    static bool canDeferMembers(const CXXRecordDecl *Instantiation);
+
+    /// \brief Collect the names of the members of \p Pattern whose
+    /// instantiation can be deferred: those for which every member of
+    /// \p Pattern with that name could be deferred.
+    static void
+    collectDeferrableNames(const CXXRecordDecl *Pattern,
+                           llvm::DenseSet<DeclarationName> &Names);
+
+    /// \brief Defer the instantiation of the member \p Member of the pattern
+    /// of \p Instantiation, if its name is one of \p DeferrableNames.
+    ///
+    /// \returns true if the member was deferred.
+    bool deferMember(CXXRecordDecl *Instantiation, Decl *Member,
+                     const llvm::DenseSet<DeclarationName> &DeferrableNames,
+                     const MultiLevelTemplateArgumentList &TemplateArgs,
+                     SourceLocation PointOfInstantiation);
+
+    /// \brief Instantiate all the pending members of \p Record.
+    void instantiateAll(const CXXRecordDecl *Record) {
+      instantiate(Record, [](NamedDecl *) { return true; });
+    }
+
+    /// \brief Stop instantiating members, because the Sema is going away.
+    void detach() { SemaRef = nullptr; }
+
+    bool FindExternalVisibleDeclsByName(const DeclContext *DC,
+                                        DeclarationName Name) override;
+    void completeVisibleDeclsMap(const DeclContext *DC) override;
+    void PrintStats() override;
+  };
 }
 
 #endif // LLVM_CLANG_SEMA_TEMPLATE_H
@@ -610,6 +610,14 @@ namespace clang {
 
       /// \brief The stack of open #ifs/#ifdefs recorded in a preamble.
       PP_CONDITIONAL_STACK = 62,
+
+      /// \brief Record code for the identifier filter.
+      ///
+      /// The identifier filter is a blob containing a blocked Bloom filter
+      /// over the hashes of the identifiers in the IDENTIFIER_TABLE, used to
+      /// reject lookups of identifiers that are not in the table without
+      /// probing it. AST files without this record are always probed.
+      IDENTIFIER_FILTER = 63,
     };
 
     /// \brief Record types used within a source manager block.
@@ -1217,6 +1225,10 @@ namespace clang {
       DECL_PRAGMA_DETECT_MISMATCH,
       /// \brief An OMPDeclareReductionDecl record.
       DECL_OMP_DECLARE_REDUCTION,
+      /// \brief A zlib-compressed DECL_CONTEXT_VISIBLE record. The record
+      /// holds the size of the uncompressed lookup table, which is
+      /// decompressed when the DeclContext is deserialized.
+      DECL_CONTEXT_VISIBLE_COMPRESSED,
     };
 
     /// \brief Record codes for each kind of statement or expression.
@@ -80,6 +80,7 @@ class MacroDirective;
 class ModuleMacro;
 class NamedDecl;
 class OpaqueValueExpr;
+class PrefetchedStatCache;
 class Preprocessor;
 class PreprocessorOptions;
 class Sema;
@@ -933,6 +934,10 @@ private:
   /// \brief The number of lookups into identifier tables that succeed.
   unsigned NumIdentifierLookupHits = 0;
 
+  /// \brief The number of lookups into identifier tables that were rejected
+  /// by the tables' identifier filters without probing them.
+  unsigned NumIdentifierFilterRejections = 0;
+
   /// \brief The number of selectors that have been read.
   unsigned NumSelectorsRead = 0;
 
@@ -964,6 +969,16 @@ private:
   /// Number of visible decl contexts read/total.
   unsigned NumVisibleDeclContextsRead = 0, TotalVisibleDeclContexts = 0;
 
+  /// Number of compressed lookup tables decompressed, and their total size
+  /// before and after decompression.
+  unsigned NumLookupTablesDecompressed = 0;
+  uint64_t CompressedLookupTableBytes = 0, DecompressedLookupTableBytes = 0;
+
+  /// Number of input files validated, how many of them were stat'ed in a
+  /// parallel batch, and the time spent validating them.
+  unsigned NumInputFilesValidated = 0, NumInputFileStatsPrefetched = 0;
+  llvm::TimeRecord InputFileValidationTime;
+
   /// Total size of modules, in bits, currently loaded
   uint64_t TotalModulesSizeInBits = 0;
 
@@ -1156,6 +1171,14 @@ private:
   serialization::InputFile getInputFile(ModuleFile &F, unsigned ID,
                                         bool Complain = true);
 
+  /// \brief Stat the first \p N input files of \p F in parallel, ahead of
+  /// validating them, if the file manager uses the real file system and
+  /// enough of them are unknown to it.
+  ///
+  /// \returns the stat cache holding the results, which has been installed
+  /// in the file manager and must be removed by the caller, or null.
+  PrefetchedStatCache *prefetchInputFileStats(ModuleFile &F, unsigned N);
+
 public:
   void ResolveImportedPath(ModuleFile &M, std::string &Filename);
   static void ResolveImportedPath(std::string &Filename, StringRef Prefix);
@@ -1892,6 +1915,10 @@ public:
   /// chain of the identifier.
   IdentifierInfo *get(StringRef Name) override;
 
+  /// \brief Retrieve the IdentifierInfo for the named identifier, whose hash
+  /// is \p NameHash.
+  IdentifierInfo *getWithHash(StringRef Name, unsigned NameHash) override;
+
   /// \brief Retrieve an iterator into the set of all identifiers
   /// in all loaded AST files.
   IdentifierIterator *getIdentifiers() override;
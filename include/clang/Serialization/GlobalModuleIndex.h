@@ -179,6 +179,13 @@ public:
   /// \returns true if the identifier is known to the index, false otherwise.
   bool lookupIdentifier(StringRef Name, HitSet &Hits);
 
+  /// \brief Look for all of the module files with information about the given
+  /// identifier, whose hash as computed by \c IdentifierTable::hash() is
+  /// \p NameHash.
+  ///
+  /// \returns true if the identifier is known to the index, false otherwise.
+  bool lookupIdentifier(StringRef Name, unsigned NameHash, HitSet &Hits);
+
   /// \brief Note that the given module file has been loaded.
   ///
   /// \returns false if the global module index has information about this
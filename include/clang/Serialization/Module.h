@@ -24,8 +24,10 @@
 #include "llvm/ADT/SetVector.h"
 #include "llvm/Bitcode/BitstreamReader.h"
 #include "llvm/Support/Endian.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace llvm {
 template <typename Info> class OnDiskChainedHashTable;
@@ -276,6 +278,12 @@ public:
   /// IdentifierHashTable.
   void *IdentifierLookupTable = nullptr;
 
+  /// \brief The Bloom filter over the identifiers in IdentifierLookupTable,
+  /// or empty if this AST file has none.
+  ///
+  /// This points into the memory buffer holding the AST file.
+  ArrayRef<unsigned char> IdentifierFilter;
+
   /// \brief Offsets of identifiers that we're going to preload within
   /// IdentifierTableData.
   std::vector<unsigned> PreloadIdentifierOffsets;
@@ -389,6 +397,10 @@ public:
   /// \brief The number of declarations in this AST file.
   unsigned LocalNumDecls = 0;
 
+  /// \brief The decompressed forms of the compressed lookup tables read
+  /// from this AST file.
+  std::vector<std::unique_ptr<llvm::MemoryBuffer>> DecompressedLookupTables;
+
   /// \brief Offset of each declaration within the bitstream, indexed
   /// by the declaration ID (-1).
   const DeclOffset *DeclOffsets = nullptr;
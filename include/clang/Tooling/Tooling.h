@@ -36,6 +36,7 @@
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/LLVM.h"
 #include "clang/Driver/Util.h"
+#include "clang/Frontend/DeduplicatingDiagnosticConsumer.h"
 #include "clang/Frontend/FrontendAction.h"
 #include "clang/Lex/ModuleLoader.h"
 #include "clang/Tooling/ArgumentsAdjusters.h"
@@ -246,6 +247,16 @@ public:
     this->DiagConsumer = DiagConsumer;
   }
 
+  /// \brief Report each diagnostic at most once across all the translation
+  /// units processed by this tool, e.g. a warning in a header that many of
+  /// them include.
+  ///
+  /// Diagnostics are passed on to the consumer set by
+  /// \c setDiagnosticConsumer(), or printed to stderr if there is none.
+  void setDeduplicateDiagnostics(bool Deduplicate) {
+    DeduplicateDiagnostics = Deduplicate;
+  }
+
   /// \brief Map a virtual file to be used while running the tool.
   ///
   /// \param FilePath The path at which the content will be mapped.
@@ -349,6 +360,10 @@ class ClangTool {
   ArgumentsAdjuster ArgsAdjuster;
 
   DiagnosticConsumer *DiagConsumer;
+
+  bool DeduplicateDiagnostics = false;
+  /// The diagnostics reported so far, if they are deduplicated.
+  llvm::IntrusiveRefCntPtr<DiagnosticDeduplicationSet> ReportedDiagnostics;
 };
 
 template <typename T>
@@ -833,6 +833,44 @@ ASTContext::setExternalSource(IntrusiveRefCntPtr<ExternalASTSource> Source) {
   ExternalSource = std::move(Source);
 }
 
+namespace {
+/// \brief One entry of the memory breakdown of an ASTContext.
+struct MemoryStat {
+  const char *Key;
+  const char *Description;
+  size_t Bytes;
+};
+} // end anonymous namespace
+
+static SmallVector<MemoryStat, 10> getMemoryStats(const ASTContext &Ctx) {
+  static const MemoryStat Categories[ASTContext::NumAllocationCategories] = {
+    {"decls", "in declarations", 0},
+    {"types", "in types", 0},
+    {"stmts", "in statements and expressions", 0},
+    {"template_argument_lists", "in template argument lists", 0},
+    {"attrs", "in attributes", 0},
+  };
+
+  SmallVector<MemoryStat, 10> Stats;
+  size_t Categorized = 0;
+  for (unsigned I = 0; I != ASTContext::NumAllocationCategories; ++I) {
+    Stats.push_back(Categories[I]);
+    Stats.back().Bytes = Ctx.getASTAllocatedMemory(
+        static_cast<ASTContext::AllocationCategory>(I));
+    Categorized += Stats.back().Bytes;
+  }
+  size_t Allocated = Ctx.getAllocator().getBytesAllocated();
+  Stats.push_back({"other", "in other AST data",
+                   Allocated > Categorized ? Allocated - Categorized : 0});
+  Stats.push_back({"arena", "allocated in the AST arena",
+                   Ctx.getASTAllocatedMemory()});
+  Stats.push_back({"lookup_tables", "in declaration context lookup tables",
+                   Ctx.getDeclContextLookupMemory()});
+  Stats.push_back({"side_tables", "in side tables",
+                   Ctx.getSideTableAllocatedMemory()});
+  return Stats;
+}
+
 void ASTContext::PrintStats() const {
   llvm::errs() << "\n*** AST Context Stats:\n";
   llvm::errs() << "  " << Types.size() << " types total.\n";
@@ -889,9 +927,50 @@ void ASTContext::PrintStats() const {
     ExternalSource->PrintStats();
   }
 
+  llvm::errs() << "\n*** AST Context Memory Breakdown:\n";
+  for (const MemoryStat &Stat : getMemoryStats(*this))
+    llvm::errs() << "  " << Stat.Bytes << " bytes " << Stat.Description
+                 << "\n";
+
   BumpAlloc.PrintStats();
 }
 
+void ASTContext::printMemoryStatsJSON(raw_ostream &OS) const {
+  OS << '{';
+  bool First = true;
+  for (const MemoryStat &Stat : getMemoryStats(*this)) {
+    OS << (First ? "" : ", ") << '"' << Stat.Key << "\": " << Stat.Bytes;
+    First = false;
+  }
+  OS << '}';
+}
+
+void ASTContext::printTypeStatsJSON(raw_ostream &OS) const {
+  unsigned counts[] = {
+#define TYPE(Name, Parent) 0,
+#define ABSTRACT_TYPE(Name, Parent)
+#include "clang/AST/TypeNodes.def"
+    0 // Extra
+  };
+
+  for (const Type *T : Types)
+    counts[(unsigned)T->getTypeClass()]++;
+
+  OS << '{';
+  const char *Separator = "";
+  unsigned Idx = 0;
+#define TYPE(Name, Parent)                                              \
+  if (counts[Idx]) {                                                    \
+    OS << Separator << "\"" #Name "\": {\"count\": " << counts[Idx]     \
+       << ", \"bytes\": " << counts[Idx] * sizeof(Name##Type) << '}';   \
+    Separator = ", ";                                                   \
+  }                                                                     \
+  ++Idx;
+#define ABSTRACT_TYPE(Name, Parent)
+#include "clang/AST/TypeNodes.def"
+  OS << '}';
+}
+
 void ASTContext::mergeDefinitionIntoModule(NamedDecl *ND, Module *M,
                                            bool NotifyListeners) {
   if (NotifyListeners)
@@ -3373,7 +3452,8 @@ QualType ASTContext::getFunctionTypeInternal(
     Size += NumArgs * sizeof(FunctionProtoType::ExtParameterInfo);
   }
 
-  FunctionProtoType *FTP = (FunctionProtoType*) Allocate(Size, TypeAlignment);
+  FunctionProtoType *FTP =
+      (FunctionProtoType*) Allocate(Size, TypeAlignment, AC_Type);
   FunctionProtoType::ExtProtoInfo newEPI = EPI;
   new (FTP) FunctionProtoType(ResultTy, ArgArray, Canonical, NonDesig, newEPI);
   Types.push_back(FTP);
@@ -3707,7 +3787,7 @@ ASTContext::getTemplateSpecializationType(TemplateName Template,
   void *Mem = Allocate(sizeof(TemplateSpecializationType) +
                        sizeof(TemplateArgument) * Args.size() +
                        (IsTypeAlias? sizeof(QualType) : 0),
-                       TypeAlignment);
+                       TypeAlignment, AC_Type);
   TemplateSpecializationType *Spec
     = new (Mem) TemplateSpecializationType(Template, Args, CanonType,
                                          IsTypeAlias ? Underlying : QualType());
@@ -3747,7 +3827,7 @@ QualType ASTContext::getCanonicalTemplateSpecializationType(
     // Allocate a new canonical template specialization type.
     void *Mem = Allocate((sizeof(TemplateSpecializationType) +
                           sizeof(TemplateArgument) * NumArgs),
-                         TypeAlignment);
+                         TypeAlignment, AC_Type);
     Spec = new (Mem) TemplateSpecializationType(CanonTemplate,
                                                 CanonArgs,
                                                 QualType(), QualType());
@@ -3893,7 +3973,7 @@ ASTContext::getDependentTemplateSpecializationType(
 
   void *Mem = Allocate((sizeof(DependentTemplateSpecializationType) +
                         sizeof(TemplateArgument) * NumArgs),
-                       TypeAlignment);
+                       TypeAlignment, AC_Type);
   T = new (Mem) DependentTemplateSpecializationType(Keyword, NNS,
                                                     Name, Args, Canon);
   Types.push_back(T);
@@ -4128,7 +4208,7 @@ QualType ASTContext::getObjCObjectType(
   unsigned size = sizeof(ObjCObjectTypeImpl);
   size += typeArgs.size() * sizeof(QualType);
   size += protocols.size() * sizeof(ObjCProtocolDecl *);
-  void *mem = Allocate(size, TypeAlignment);
+  void *mem = Allocate(size, TypeAlignment, AC_Type);
   ObjCObjectTypeImpl *T =
     new (mem) ObjCObjectTypeImpl(canonical, baseType, typeArgs, protocols,
                                  isKindOf);
@@ -4239,7 +4319,7 @@ ASTContext::getObjCTypeParamType(const ObjCTypeParamDecl *Decl,
 
   unsigned size = sizeof(ObjCTypeParamType);
   size += protocols.size() * sizeof(ObjCProtocolDecl *);
-  void *mem = Allocate(size, TypeAlignment);
+  void *mem = Allocate(size, TypeAlignment, AC_Type);
   ObjCTypeParamType *newType = new (mem)
     ObjCTypeParamType(Decl, Canonical, protocols);
 
@@ -4335,7 +4415,8 @@ QualType ASTContext::getObjCObjectPointerType(QualType ObjectT) const {
   }
 
   // No match.
-  void *Mem = Allocate(sizeof(ObjCObjectPointerType), TypeAlignment);
+  void *Mem =
+      Allocate(sizeof(ObjCObjectPointerType), TypeAlignment, AC_Type);
   ObjCObjectPointerType *QType =
     new (Mem) ObjCObjectPointerType(Canonical, ObjectT);
 
@@ -4361,7 +4442,7 @@ QualType ASTContext::getObjCInterfaceType(const ObjCInterfaceDecl *Decl,
   if (const ObjCInterfaceDecl *Def = Decl->getDefinition())
     Decl = Def;
   
-  void *Mem = Allocate(sizeof(ObjCInterfaceType), TypeAlignment);
+  void *Mem = Allocate(sizeof(ObjCInterfaceType), TypeAlignment, AC_Type);
   ObjCInterfaceType *T = new (Mem) ObjCInterfaceType(Decl);
   Decl->TypeForDecl = T;
   Types.push_back(T);
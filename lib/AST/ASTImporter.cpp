@@ -5127,18 +5127,19 @@ Expr *ASTNodeImporter::VisitCXXTemporaryObjectExpr(CXXTemporaryObjectExpr *CE) {
   if (!Ctor)
     return nullptr;
 
+  TypeSourceInfo *TInfo = Importer.Import(CE->getTypeSourceInfo());
+  if (!TInfo)
+    return nullptr;
+
   return CXXTemporaryObjectExpr::Create(
-        Importer.getToContext(), T,
-        Importer.Import(CE->getLocStart()),
-        Ctor,
-        CE->isElidable(),
+        Importer.getToContext(),
+        Ctor, T, TInfo,
         Args,
+        Importer.Import(CE->getParenOrBraceRange()),
         CE->hadMultipleCandidates(),
         CE->isListInitialization(),
         CE->isStdInitListInitialization(),
-        CE->requiresZeroInitialization(),
-        CE->getConstructionKind(),
-        Importer.Import(CE->getParenOrBraceRange()));
+        CE->requiresZeroInitialization());
 }
 
 Expr *
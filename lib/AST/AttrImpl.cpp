@@ -17,4 +17,9 @@
 #include "clang/AST/Type.h"
 using namespace clang;
 
+void *Attr::operator new(size_t Bytes, ASTContext &C,
+                         size_t Alignment) noexcept {
+  return C.Allocate(Bytes, Alignment, ASTContext::AC_Attr);
+}
+
 #include "clang/AST/AttrImpl.inc"
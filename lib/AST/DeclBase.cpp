@@ -56,7 +56,7 @@ void *Decl::operator new(std::size_t Size, const ASTContext &Context,
   // resulting pointer will still be 8-byte aligned.
   static_assert(sizeof(unsigned) * 2 >= alignof(Decl),
                 "Decl won't be misaligned");
-  void *Start = Context.Allocate(Size + Extra + 8);
+  void *Start = Context.Allocate(Size + Extra + 8, 8, ASTContext::AC_Decl);
   void *Result = (char*)Start + 8;
 
   unsigned *PrefixPtr = (unsigned *)Result - 2;
@@ -81,13 +81,14 @@ void *Decl::operator new(std::size_t Size, const ASTContext &Ctx,
     size_t ExtraAlign =
         llvm::OffsetToAlignment(sizeof(Module *), alignof(Decl));
     char *Buffer = reinterpret_cast<char *>(
-        ::operator new(ExtraAlign + sizeof(Module *) + Size + Extra, Ctx));
+        Ctx.Allocate(ExtraAlign + sizeof(Module *) + Size + Extra, 8,
+                     ASTContext::AC_Decl));
     Buffer += ExtraAlign;
     auto *ParentModule =
         Parent ? cast<Decl>(Parent)->getOwningModule() : nullptr;
     return new (Buffer) Module*(ParentModule) + 1;
   }
-  return ::operator new(Size + Extra, Ctx);
+  return Ctx.Allocate(Size + Extra, 8, ASTContext::AC_Decl);
 }
 
 Module *Decl::getOwningModuleSlow() const {
@@ -169,6 +170,26 @@ void Decl::PrintStats() {
   llvm::errs() << "Total bytes = " << totalBytes << "\n";
 }
 
+void Decl::PrintStatsJSON(raw_ostream &OS) {
+  OS << '{';
+  const char *Separator = "";
+#define DECL(DERIVED, BASE)                                             \
+  if (n##DERIVED##s > 0) {                                              \
+    OS << Separator << "\"" #DERIVED "\": {\"count\": " << n##DERIVED##s \
+       << ", \"bytes\": " << n##DERIVED##s * sizeof(DERIVED##Decl) << '}'; \
+    Separator = ", ";                                                   \
+  }
+#define ABSTRACT_DECL(DECL)
+#include "clang/AST/DeclNodes.inc"
+  OS << '}';
+}
+
+void Decl::ResetStatistics() {
+#define DECL(DERIVED, BASE) n##DERIVED##s = 0;
+#define ABSTRACT_DECL(DECL)
+#include "clang/AST/DeclNodes.inc"
+}
+
 void Decl::add(Kind k) {
   switch (k) {
 #define DECL(DERIVED, BASE) case DERIVED: ++n##DERIVED##s; break;
@@ -1833,6 +1854,20 @@ void ASTContext::ReleaseDeclContextMaps() {
   StoredDeclsMap::DestroyAll(LastSDM.getPointer(), LastSDM.getInt());
 }
 
+size_t ASTContext::getDeclContextLookupMemory() const {
+  size_t Bytes = 0;
+  for (llvm::PointerIntPair<StoredDeclsMap*,1> Map = LastSDM;
+       Map.getPointer(); Map = Map.getPointer()->Previous) {
+    Bytes += Map.getInt() ? sizeof(DependentStoredDeclsMap)
+                          : sizeof(StoredDeclsMap);
+    Bytes += Map.getPointer()->getMemorySize();
+    for (const auto &Entry : *Map.getPointer())
+      if (StoredDeclsList::DeclsTy *Vector = Entry.second.getAsVector())
+        Bytes += sizeof(*Vector) + llvm::capacity_in_bytes(*Vector);
+  }
+  return Bytes;
+}
+
 void StoredDeclsMap::DestroyAll(StoredDeclsMap *Map, bool Dependent) {
   while (Map) {
     // Advance the iteration before we invalidate memory.
@@ -676,7 +676,9 @@ TemplateArgumentList::TemplateArgumentList(ArrayRef<TemplateArgument> Args)
 TemplateArgumentList *
 TemplateArgumentList::CreateCopy(ASTContext &Context,
                                  ArrayRef<TemplateArgument> Args) {
-  void *Mem = Context.Allocate(totalSizeToAlloc<TemplateArgument>(Args.size()));
+  void *Mem = Context.Allocate(totalSizeToAlloc<TemplateArgument>(Args.size()),
+                               alignof(TemplateArgumentList),
+                               ASTContext::AC_TemplateArgumentList);
   return new (Mem) TemplateArgumentList(Args);
 }
 
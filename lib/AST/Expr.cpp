@@ -1157,13 +1157,25 @@ OverloadedOperatorKind UnaryOperator::getOverloadedOperator(Opcode Opc) {
 // Postfix Operators.
 //===----------------------------------------------------------------------===//
 
+SyntacticCallArgs *SyntacticCallArgs::Create(const ASTContext &C,
+                                             ArrayRef<Expr *> Args) {
+  void *Mem = C.Allocate(totalSizeToAlloc<Expr *>(Args.size()),
+                         alignof(SyntacticCallArgs));
+  return new (Mem) SyntacticCallArgs(Args);
+}
+
+// Calls are among the most common expressions; the arguments as written are
+// kept out of line as they are rarely needed.
+static_assert(sizeof(void *) != 8 || sizeof(CallExpr) <= 40,
+              "CallExpr grew larger than expected");
+
 CallExpr::CallExpr(const ASTContext &C, StmtClass SC, Expr *fn,
                    ArrayRef<Expr *> preargs, ArrayRef<Expr *> args, QualType t,
                    ExprValueKind VK, SourceLocation rparenloc)
     : Expr(SC, t, VK, OK_Ordinary, fn->isTypeDependent(),
            fn->isValueDependent(), fn->isInstantiationDependent(),
            fn->containsUnexpandedParameterPack()),
-      SyntacticArgs(nullptr), NumArgs(args.size()), NumSyntacticArgs(0) {
+      SyntacticArgs(nullptr), NumArgs(args.size()) {
 
   unsigned NumPreArgs = preargs.size();
   SubExprs = new (C) Stmt *[args.size()+PREARGS_START+NumPreArgs];
@@ -1197,8 +1209,7 @@ CallExpr::CallExpr(const ASTContext &C, StmtClass SC, EmptyShell Empty)
 
 CallExpr::CallExpr(const ASTContext &C, StmtClass SC, unsigned NumPreArgs,
                    EmptyShell Empty)
-    : Expr(SC, Empty), SubExprs(nullptr), SyntacticArgs(nullptr), NumArgs(0),
-      NumSyntacticArgs(0) {
+    : Expr(SC, Empty), SubExprs(nullptr), SyntacticArgs(nullptr), NumArgs(0) {
   // FIXME: Why do we allocate this?
   SubExprs = new (C) Stmt *[PREARGS_START + NumPreArgs]();
   CallExprBits.NumPreArgs = NumPreArgs;
@@ -1278,12 +1289,9 @@ void CallExpr::setNumArgs(const ASTContext& C, unsigned NumArgs) {
 
 /// setSyntacticArgs - Only if there's any designated args will this be set.
 void CallExpr::setSyntacticArgs(const ASTContext &C, ArrayRef<Expr *> Args) {
-  Expr **NewSyntacticArgs = new (C) Expr *[Args.size()];
-  std::copy(Args.begin(), Args.end(), NewSyntacticArgs);
   if (SyntacticArgs)
     C.Deallocate(SyntacticArgs);
-  SyntacticArgs = NewSyntacticArgs;
-  NumSyntacticArgs = Args.size();
+  SyntacticArgs = SyntacticCallArgs::Create(C, Args);
 }
 
 /// getBuiltinCallee - If this is a call to a builtin, return the builtin ID. If
@@ -743,8 +743,18 @@ CXXBindTemporaryExpr *CXXBindTemporaryExpr::Create(const ASTContext &C,
   return new (C) CXXBindTemporaryExpr(Temp, SubExpr);
 }
 
-CXXTemporaryObjectExpr::CXXTemporaryObjectExpr(const ASTContext &C,
-                                               CXXConstructorDecl *Cons,
+// Construction expressions are among the most common expressions in C++;
+// their flags live in the Stmt bit-fields and their arguments follow them.
+static_assert(sizeof(void *) != 8 || sizeof(CXXConstructExpr) <= 48,
+              "CXXConstructExpr grew larger than expected");
+static_assert(sizeof(void *) != 8 || sizeof(CXXTemporaryObjectExpr) <= 56,
+              "CXXTemporaryObjectExpr grew larger than expected");
+static_assert(alignof(CXXConstructExpr) >= alignof(Stmt *) &&
+                  sizeof(CXXConstructExpr) % alignof(Stmt *) == 0 &&
+                  sizeof(CXXTemporaryObjectExpr) % alignof(Stmt *) == 0,
+              "arguments of construction expressions would be misaligned");
+
+CXXTemporaryObjectExpr::CXXTemporaryObjectExpr(CXXConstructorDecl *Cons,
                                                QualType Type,
                                                TypeSourceInfo *TSI,
                                                ArrayRef<Expr*> Args,
@@ -753,7 +763,7 @@ CXXTemporaryObjectExpr::CXXTemporaryObjectExpr(const ASTContext &C,
                                                bool ListInitialization,
                                                bool StdInitListInitialization,
                                                bool ZeroInitialization)
-  : CXXConstructExpr(C, CXXTemporaryObjectExprClass, Type,
+  : CXXConstructExpr(CXXTemporaryObjectExprClass, Type,
                      TSI->getTypeLoc().getBeginLoc(),
                      Cons, false, Args,
                      HadMultipleCandidates,
@@ -764,6 +774,33 @@ CXXTemporaryObjectExpr::CXXTemporaryObjectExpr(const ASTContext &C,
     Type(TSI) {
 }
 
+CXXTemporaryObjectExpr *
+CXXTemporaryObjectExpr::Create(const ASTContext &C, CXXConstructorDecl *Cons,
+                               QualType Type, TypeSourceInfo *TSI,
+                               ArrayRef<Expr *> Args,
+                               SourceRange ParenOrBraceRange,
+                               bool HadMultipleCandidates,
+                               bool ListInitialization,
+                               bool StdInitListInitialization,
+                               bool ZeroInitialization) {
+  void *Mem = C.Allocate(sizeToAllocate(CXXTemporaryObjectExprClass,
+                                        Args.size()),
+                         alignof(CXXTemporaryObjectExpr), ASTContext::AC_Stmt);
+  return new (Mem) CXXTemporaryObjectExpr(Cons, Type, TSI, Args,
+                                          ParenOrBraceRange,
+                                          HadMultipleCandidates,
+                                          ListInitialization,
+                                          StdInitListInitialization,
+                                          ZeroInitialization);
+}
+
+CXXTemporaryObjectExpr *
+CXXTemporaryObjectExpr::CreateEmpty(const ASTContext &C, unsigned NumArgs) {
+  void *Mem = C.Allocate(sizeToAllocate(CXXTemporaryObjectExprClass, NumArgs),
+                         alignof(CXXTemporaryObjectExpr), ASTContext::AC_Stmt);
+  return new (Mem) CXXTemporaryObjectExpr(EmptyShell(), NumArgs);
+}
+
 SourceLocation CXXTemporaryObjectExpr::getLocStart() const {
   return Type->getTypeLoc().getBeginLoc();
 }
@@ -786,15 +823,25 @@ CXXConstructExpr *CXXConstructExpr::Create(const ASTContext &C, QualType T,
                                            bool ZeroInitialization,
                                            ConstructionKind ConstructKind,
                                            SourceRange ParenOrBraceRange) {
-  return new (C) CXXConstructExpr(C, CXXConstructExprClass, T, Loc,
-                                  Ctor, Elidable, Args,
-                                  HadMultipleCandidates, ListInitialization,
-                                  StdInitListInitialization,
-                                  ZeroInitialization, ConstructKind,
-                                  ParenOrBraceRange);
+  void *Mem = C.Allocate(sizeToAllocate(CXXConstructExprClass, Args.size()),
+                         alignof(CXXConstructExpr), ASTContext::AC_Stmt);
+  return new (Mem) CXXConstructExpr(CXXConstructExprClass, T, Loc,
+                                    Ctor, Elidable, Args,
+                                    HadMultipleCandidates, ListInitialization,
+                                    StdInitListInitialization,
+                                    ZeroInitialization, ConstructKind,
+                                    ParenOrBraceRange);
+}
+
+CXXConstructExpr *CXXConstructExpr::CreateEmpty(const ASTContext &C,
+                                                unsigned NumArgs) {
+  void *Mem = C.Allocate(sizeToAllocate(CXXConstructExprClass, NumArgs),
+                         alignof(CXXConstructExpr), ASTContext::AC_Stmt);
+  return new (Mem) CXXConstructExpr(CXXConstructExprClass, EmptyShell(),
+                                    NumArgs);
 }
 
-CXXConstructExpr::CXXConstructExpr(const ASTContext &C, StmtClass SC,
+CXXConstructExpr::CXXConstructExpr(StmtClass SC,
                                    QualType T, SourceLocation Loc,
                                    CXXConstructorDecl *Ctor,
                                    bool Elidable,
@@ -809,40 +856,48 @@ CXXConstructExpr::CXXConstructExpr(const ASTContext &C, StmtClass SC,
          T->isDependentType(), T->isDependentType(),
          T->isInstantiationDependentType(),
          T->containsUnexpandedParameterPack()),
-    Constructor(Ctor), Loc(Loc), ParenOrBraceRange(ParenOrBraceRange),
-    NumArgs(Args.size()), NumSyntacticArgs(0),
-    Elidable(Elidable), HadMultipleCandidates(HadMultipleCandidates),
-    ListInitialization(ListInitialization),
-    StdInitListInitialization(StdInitListInitialization),
-    ZeroInitialization(ZeroInitialization),
-    ConstructKind(ConstructKind), Args(nullptr), SyntacticArgs(nullptr)
+    Constructor(Ctor), SyntacticArgs(nullptr), Loc(Loc),
+    ParenOrBraceRange(ParenOrBraceRange), NumArgs(Args.size())
 {
-  if (NumArgs) {
-    this->Args = new (C) Stmt*[Args.size()];
-    
-    for (unsigned i = 0; i != Args.size(); ++i) {
-      assert(Args[i] && "NULL argument in CXXConstructExpr");
+  CXXConstructExprBits.Elidable = Elidable;
+  CXXConstructExprBits.HadMultipleCandidates = HadMultipleCandidates;
+  CXXConstructExprBits.ListInitialization = ListInitialization;
+  CXXConstructExprBits.StdInitListInitialization = StdInitListInitialization;
+  CXXConstructExprBits.ZeroInitialization = ZeroInitialization;
+  CXXConstructExprBits.ConstructionKind = ConstructKind;
+
+  Stmt **TrailingArgs = getTrailingArgs();
+  for (unsigned i = 0; i != Args.size(); ++i) {
+    assert(Args[i] && "NULL argument in CXXConstructExpr");
+
+    if (Args[i]->isValueDependent())
+      ExprBits.ValueDependent = true;
+    if (Args[i]->isInstantiationDependent())
+      ExprBits.InstantiationDependent = true;
+    if (Args[i]->containsUnexpandedParameterPack())
+      ExprBits.ContainsUnexpandedParameterPack = true;
 
-      if (Args[i]->isValueDependent())
-        ExprBits.ValueDependent = true;
-      if (Args[i]->isInstantiationDependent())
-        ExprBits.InstantiationDependent = true;
-      if (Args[i]->containsUnexpandedParameterPack())
-        ExprBits.ContainsUnexpandedParameterPack = true;
-  
-      this->Args[i] = Args[i];
-    }
+    TrailingArgs[i] = Args[i];
   }
 }
 
+CXXConstructExpr::CXXConstructExpr(StmtClass SC, EmptyShell Empty,
+                                   unsigned NumArgs)
+    : Expr(SC, Empty), Constructor(nullptr), SyntacticArgs(nullptr),
+      NumArgs(NumArgs) {
+  CXXConstructExprBits.Elidable = false;
+  CXXConstructExprBits.HadMultipleCandidates = false;
+  CXXConstructExprBits.ListInitialization = false;
+  CXXConstructExprBits.StdInitListInitialization = false;
+  CXXConstructExprBits.ZeroInitialization = false;
+  CXXConstructExprBits.ConstructionKind = CK_Complete;
+}
+
 void CXXConstructExpr::setSyntacticArgs(const ASTContext &C,
                                         ArrayRef<Expr *> Args) {
-  Expr **NewSyntacticArgs = new (C) Expr *[Args.size()];
-  std::copy(Args.begin(), Args.end(), NewSyntacticArgs);
   if (SyntacticArgs)
     C.Deallocate(SyntacticArgs);
-  SyntacticArgs = NewSyntacticArgs;
-  NumSyntacticArgs = Args.size();
+  SyntacticArgs = SyntacticCallArgs::Create(C, Args);
 }
 LambdaCapture::LambdaCapture(SourceLocation Loc, bool Implicit,
                              LambdaCaptureKind Kind, VarDecl *Var,
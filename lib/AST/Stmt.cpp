@@ -52,7 +52,7 @@ static StmtClassNameTable &getStmtInfoTableEntry(Stmt::StmtClass E) {
 
 void *Stmt::operator new(size_t bytes, const ASTContext& C,
                          unsigned alignment) {
-  return ::operator new(bytes, C, alignment);
+  return C.Allocate(bytes, alignment, ASTContext::AC_Stmt);
 }
 
 const char *Stmt::getStmtClassName() const {
@@ -84,6 +84,28 @@ void Stmt::PrintStats() {
   llvm::errs() << "Total bytes = " << sum << "\n";
 }
 
+void Stmt::PrintStatsJSON(raw_ostream &OS) {
+  // Ensure the table is primed.
+  getStmtInfoTableEntry(Stmt::NullStmtClass);
+
+  OS << '{';
+  const char *Separator = "";
+  for (int i = 0; i != Stmt::lastStmtConstant+1; i++) {
+    if (StmtClassInfo[i].Name == nullptr) continue;
+    if (StmtClassInfo[i].Counter == 0) continue;
+    OS << Separator << '"' << StmtClassInfo[i].Name << "\": {\"count\": "
+       << StmtClassInfo[i].Counter << ", \"bytes\": "
+       << StmtClassInfo[i].Counter*StmtClassInfo[i].Size << '}';
+    Separator = ", ";
+  }
+  OS << '}';
+}
+
+void Stmt::ResetStatistics() {
+  for (int i = 0; i != Stmt::lastStmtConstant+1; i++)
+    StmtClassInfo[i].Counter = 0;
+}
+
 void Stmt::addStmtClass(StmtClass s) {
   ++getStmtInfoTableEntry(s).Counter;
 }
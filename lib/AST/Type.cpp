@@ -184,6 +184,11 @@ VectorType::VectorType(TypeClass tc, QualType vecType, unsigned nElements,
   VectorTypeBits.NumElements = nElements;
 }
 
+void *Type::operator new(size_t Bytes, const ASTContext &C,
+                         size_t Alignment) {
+  return C.Allocate(Bytes, Alignment, ASTContext::AC_Type);
+}
+
 /// getArrayElementTypeNoTypeQual - If this is an array type, return the
 /// element type of the array, potentially with type qualifiers missing.
 /// This method should never be used when type qualifiers are meaningful.
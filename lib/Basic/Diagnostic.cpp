@@ -133,6 +133,7 @@ void DiagnosticsEngine::Reset() {
   // through command-line.
   DiagStates.emplace_back();
   DiagStatesByLoc.appendFirst(&DiagStates.back());
+  invalidateNeverEnabled();
 }
 
 void DiagnosticsEngine::SetDelayedDiagnostic(unsigned DiagID, StringRef Arg1,
@@ -191,8 +192,11 @@ DiagnosticsEngine::DiagStateMap::lookup(SourceManager &SrcMgr,
     return FirstDiagState;
 
   std::pair<FileID, unsigned> Decomp = SrcMgr.getDecomposedLoc(Loc);
-  const File *F = getFile(SrcMgr, Decomp.first);
-  return F->lookup(Decomp.second);
+  if (!LastLookupFile || Decomp.first != LastLookupFID) {
+    LastLookupFID = Decomp.first;
+    LastLookupFile = getFile(SrcMgr, Decomp.first);
+  }
+  return LastLookupFile->lookup(Decomp.second);
 }
 
 DiagnosticsEngine::DiagState *
@@ -235,6 +239,20 @@ DiagnosticsEngine::DiagStateMap::getFile(SourceManager &SrcMgr,
   return &F;
 }
 
+bool DiagnosticsEngine::computeNeverEnabled(unsigned DiagID) const {
+  if (DiagID >= diag::DIAG_UPPER_LIMIT)
+    return false;
+
+  if (NeverEnabledKnown.empty()) {
+    NeverEnabled.resize(diag::DIAG_UPPER_LIMIT);
+    NeverEnabledKnown.resize(diag::DIAG_UPPER_LIMIT);
+  }
+  bool Result = Diags->isIgnoredInEveryState(DiagID, *this);
+  NeverEnabled[DiagID] = Result;
+  NeverEnabledKnown.set(DiagID);
+  return Result;
+}
+
 void DiagnosticsEngine::PushDiagStatePoint(DiagState *State,
                                            SourceLocation Loc) {
   assert(Loc.isValid() && "Adding invalid loc point");
@@ -263,6 +281,9 @@ void DiagnosticsEngine::setSeverity(diag::kind Diag, diag::Severity Map,
   DiagnosticMapping Mapping = makeUserMapping(Map, L);
   Mapping.setUpgradedFromWarning(WasUpgradedFromWarning);
 
+  if (Diag < NeverEnabledKnown.size())
+    NeverEnabledKnown.reset(Diag);
+
   // Common case; setting all the diagnostics of a group in one place.
   if ((L.isInvalid() || L == DiagStatesByLoc.getCurDiagStateLoc()) &&
       DiagStatesByLoc.getCurDiagState()) {
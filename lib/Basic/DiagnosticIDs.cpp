@@ -476,6 +476,33 @@ DiagnosticIDs::getDiagnosticSeverity(unsigned DiagID, SourceLocation Loc,
   return Result;
 }
 
+bool DiagnosticIDs::isIgnoredInEveryState(
+    unsigned DiagID, const DiagnosticsEngine &Diag) const {
+  unsigned DiagClass = getBuiltinDiagClass(DiagID);
+  if (DiagClass != CLASS_WARNING && DiagClass != CLASS_EXTENSION &&
+      DiagClass != CLASS_REMARK)
+    return false;
+  bool IsExtensionDiag = DiagClass == CLASS_EXTENSION;
+
+  // This mirrors the ways getDiagnosticSeverity() can map a diagnostic to
+  // something other than Ignored, independently of its location.
+  for (const DiagnosticsEngine::DiagState &State : Diag.DiagStates) {
+    DiagnosticMapping Mapping = State.lookupMapping((diag::kind)DiagID);
+    if (Mapping.getSeverity() == diag::Severity())
+      Mapping = GetDefaultDiagMapping(DiagID);
+
+    if (Mapping.getSeverity() != diag::Severity::Ignored)
+      return false;
+    if (Mapping.isUser())
+      continue;
+    if (State.EnableAllWarnings && DiagClass != CLASS_REMARK)
+      return false;
+    if (IsExtensionDiag && State.ExtBehavior != diag::Severity::Ignored)
+      return false;
+  }
+  return true;
+}
+
 #define GET_DIAG_ARRAYS
 #include "clang/Basic/DiagnosticGroups.inc"
 #undef GET_DIAG_ARRAYS
@@ -321,6 +321,21 @@ const FileEntry *FileManager::getFile(StringRef Filename, bool openFile,
   return &UFE;
 }
 
+bool FileManager::isKnownFile(StringRef Filename) const {
+  auto Known = SeenFileEntries.find(Filename);
+  return Known != SeenFileEntries.end() && Known->second &&
+         Known->second != NON_EXISTENT_FILE;
+}
+
+bool FileManager::isKnownDirectory(StringRef DirName) const {
+  // Directory lookups are keyed without trailing separators.
+  while (DirName.size() > 1 && llvm::sys::path::is_separator(DirName.back()))
+    DirName = DirName.drop_back();
+  auto Known = SeenDirEntries.find(DirName);
+  return Known != SeenDirEntries.end() && Known->second &&
+         Known->second != NON_EXISTENT_DIR;
+}
+
 const FileEntry *
 FileManager::getVirtualFile(StringRef Filename, off_t Size,
                             time_t ModificationTime) {
@@ -417,7 +432,8 @@ bool FileManager::makeAbsolutePath(SmallVectorImpl<char> &Path) const {
 
 llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
 FileManager::getBufferForFile(const FileEntry *Entry, bool isVolatile,
-                              bool ShouldCloseOpenFile) {
+                              bool ShouldCloseOpenFile,
+                              bool RequiresNullTerminator) {
   uint64_t FileSize = Entry->getSize();
   // If there's a high enough chance that the file have changed since we
   // got its size, force a stat before opening it.
@@ -428,8 +444,8 @@ FileManager::getBufferForFile(const FileEntry *Entry, bool isVolatile,
   // If the file is already open, use the open file descriptor.
   if (Entry->File) {
     auto Result =
-        Entry->File->getBuffer(Filename, FileSize,
-                               /*RequiresNullTerminator=*/true, isVolatile);
+        Entry->File->getBuffer(Filename, FileSize, RequiresNullTerminator,
+                               isVolatile);
     // FIXME: we need a set of APIs that can make guarantees about whether a
     // FileEntry is open or not.
     if (ShouldCloseOpenFile)
@@ -440,13 +456,13 @@ FileManager::getBufferForFile(const FileEntry *Entry, bool isVolatile,
   // Otherwise, open the file.
 
   if (FileSystemOpts.WorkingDir.empty())
-    return FS->getBufferForFile(Filename, FileSize,
-                                /*RequiresNullTerminator=*/true, isVolatile);
+    return FS->getBufferForFile(Filename, FileSize, RequiresNullTerminator,
+                                isVolatile);
 
   SmallString<128> FilePath(Entry->getName());
   FixupRelativePath(FilePath);
-  return FS->getBufferForFile(FilePath, FileSize,
-                              /*RequiresNullTerminator=*/true, isVolatile);
+  return FS->getBufferForFile(FilePath, FileSize, RequiresNullTerminator,
+                              isVolatile);
 }
 
 llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
@@ -13,7 +13,11 @@
 
 #include "clang/Basic/FileSystemStatCache.h"
 #include "clang/Basic/VirtualFileSystem.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/ThreadPool.h"
+#include <algorithm>
+#include <vector>
 
 using namespace clang;
 
@@ -124,3 +128,59 @@ MemorizeStatCalls::getStat(StringRef Path, FileData &Data, bool isFile,
 
   return Result;
 }
+
+void PrefetchedStatCache::prefetch(ArrayRef<std::string> Paths,
+                                   vfs::FileSystem &FS, unsigned NumThreads) {
+  std::vector<std::pair<LookupResult, FileData>> Stats(Paths.size());
+  auto StatRange = [&](size_t Begin, size_t End) {
+    for (size_t I = Begin; I != End; ++I) {
+      llvm::ErrorOr<vfs::Status> Status = FS.status(Paths[I]);
+      if (!Status) {
+        Stats[I].first = CacheMissing;
+        continue;
+      }
+      Stats[I].first = CacheExists;
+      copyStatusToFileData(*Status, Stats[I].second);
+    }
+  };
+
+  // Other file systems, such as overlays, may keep state that is not safe to
+  // access from several threads.
+  if (&FS != vfs::getRealFileSystem().get())
+    NumThreads = 1;
+
+  NumThreads = std::max(1u, std::min<unsigned>(NumThreads, Paths.size()));
+  if (NumThreads == 1) {
+    StatRange(0, Paths.size());
+  } else {
+    // Hand each thread a contiguous slice; the results are merged in order
+    // below, so only the file system is accessed concurrently.
+    llvm::ThreadPool Pool(NumThreads);
+    size_t SliceSize = (Paths.size() + NumThreads - 1) / NumThreads;
+    for (size_t Begin = 0; Begin < Paths.size(); Begin += SliceSize) {
+      size_t End = std::min(Begin + SliceSize, Paths.size());
+      Pool.async([&StatRange, Begin, End] { StatRange(Begin, End); });
+    }
+    Pool.wait();
+  }
+
+  for (size_t I = 0, E = Paths.size(); I != E; ++I)
+    Results[Paths[I]] = std::move(Stats[I]);
+}
+
+PrefetchedStatCache::LookupResult
+PrefetchedStatCache::getStat(StringRef Path, FileData &Data, bool isFile,
+                             std::unique_ptr<vfs::File> *F,
+                             vfs::FileSystem &FS) {
+  // Clients that want the file opened are better served by open+fstat.
+  if (F)
+    return statChained(Path, Data, isFile, F, FS);
+
+  auto Known = Results.find(Path);
+  if (Known == Results.end())
+    return statChained(Path, Data, isFile, F, FS);
+
+  if (Known->second.first == CacheExists)
+    Data = Known->second.second;
+  return Known->second.first;
+}
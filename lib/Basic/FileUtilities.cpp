@@ -0,0 +1,43 @@
+//===--- FileUtilities.cpp - Miscellaneous file utilities -----------------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements helpers for writing files on disk.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Basic/FileUtilities.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace clang;
+
+bool clang::writeFileAtomically(StringRef Path, StringRef Contents) {
+  SmallString<128> TmpPath;
+  int TmpFD;
+  if (llvm::sys::fs::createUniqueFile(Path + "-%%%%%%%%", TmpFD, TmpPath))
+    return true;
+
+  {
+    llvm::raw_fd_ostream Out(TmpFD, /*shouldClose=*/true);
+    Out << Contents;
+    Out.close();
+    if (Out.has_error()) {
+      Out.clear_error();
+      llvm::sys::fs::remove(TmpPath);
+      return true;
+    }
+  }
+
+  if (llvm::sys::fs::rename(TmpPath, Path)) {
+    llvm::sys::fs::remove(TmpPath);
+    return true;
+  }
+  return false;
+}
@@ -28,8 +28,12 @@
 
 using namespace clang;
 using namespace SrcMgr;
+
 using llvm::MemoryBuffer;
 
+static_assert(sizeof(SLocEntry) == sizeof(unsigned) + sizeof(ExpansionInfo),
+              "SLocEntry should not grow beyond an offset and ExpansionInfo");
+
 //===----------------------------------------------------------------------===//
 // SourceManager Helper Classes
 //===----------------------------------------------------------------------===//
@@ -301,7 +305,7 @@ SourceManager::SourceManager(DiagnosticsEngine &Diag, FileManager &FileMgr,
   : Diag(Diag), FileMgr(FileMgr), OverridenFilesKeepOriginalName(true),
     UserFilesAreVolatile(UserFilesAreVolatile), FilesAreTransient(false),
     ExternalSLocEntries(nullptr), LineTable(nullptr), NumLinearScans(0),
-    NumBinaryProbes(0) {
+    NumBinaryProbes(0), NumPageLookups(0) {
   clearIDTables();
   Diag.setSourceManager(this);
 }
@@ -335,6 +339,8 @@ void SourceManager::clearIDTables() {
   LastLineNoFileIDQuery = FileID();
   LastLineNoContentCache = nullptr;
   LastFileIDLookup = FileID();
+  LocalSLocPageIndex.clear();
+  LoadedSLocAllocations.clear();
 
   if (LineTable)
     LineTable->clear();
@@ -440,7 +446,7 @@ const SrcMgr::SLocEntry &SourceManager::loadSLocEntry(unsigned Index,
     if (!SLocEntryLoaded[Index]) {
       // Try to recover; create a SLocEntry so the rest of clang can handle it.
       LoadedSLocEntryTable[Index] = SLocEntry::get(0,
-                                 FileInfo::get(SourceLocation(),
+                                 createFileInfo(SourceLocation(),
                                                getFakeContentCacheForRecovery(),
                                                SrcMgr::C_User));
     }
@@ -456,6 +462,10 @@ SourceManager::AllocateLoadedSLocEntries(unsigned NumSLocEntries,
   // Make sure we're not about to run out of source locations.
   if (CurrentLoadedOffset - TotalSize < NextLocalOffset)
     return std::make_pair(0, 0);
+  LoadedSLocAllocation Allocation;
+  Allocation.BaseIndex = LoadedSLocEntryTable.size();
+  Allocation.BaseOffset = CurrentLoadedOffset - TotalSize;
+  LoadedSLocAllocations.push_back(Allocation);
   LoadedSLocEntryTable.resize(LoadedSLocEntryTable.size() + NumSLocEntries);
   SLocEntryLoaded.resize(LoadedSLocEntryTable.size());
   CurrentLoadedOffset -= TotalSize;
@@ -526,6 +536,15 @@ FileID SourceManager::getNextFileID(FileID FID) const {
 // Methods to create new FileID's and macro expansions.
 //===----------------------------------------------------------------------===//
 
+const SrcMgr::FileInfo *
+SourceManager::createFileInfo(SourceLocation IncludePos,
+                              const ContentCache *File,
+                              SrcMgr::CharacteristicKind FileCharacter) const {
+  // FileInfos live as long as the content caches they refer to.
+  return new (ContentCacheAlloc.Allocate<FileInfo>())
+      FileInfo(FileInfo::get(IncludePos, File, FileCharacter));
+}
+
 /// createFileID - Create a new FileID for the specified ContentCache and
 /// include position.  This works regardless of whether the ContentCache
 /// corresponds to a file or some other input source.
@@ -539,13 +558,13 @@ FileID SourceManager::createFileID(const ContentCache *File,
     assert(Index < LoadedSLocEntryTable.size() && "FileID out of range");
     assert(!SLocEntryLoaded[Index] && "FileID already loaded");
     LoadedSLocEntryTable[Index] = SLocEntry::get(LoadedOffset,
-        FileInfo::get(IncludePos, File, FileCharacter));
+        createFileInfo(IncludePos, File, FileCharacter));
     SLocEntryLoaded[Index] = true;
     return FileID::get(LoadedID);
   }
   LocalSLocEntryTable.push_back(SLocEntry::get(NextLocalOffset,
-                                               FileInfo::get(IncludePos, File,
-                                                             FileCharacter)));
+                                               createFileInfo(IncludePos, File,
+                                                              FileCharacter)));
   unsigned FileSize = File->getSize();
   assert(NextLocalOffset + FileSize + 1 > NextLocalOffset &&
          NextLocalOffset + FileSize + 1 <= CurrentLoadedOffset &&
@@ -743,10 +762,19 @@ FileID SourceManager::getFileIDLocal(unsigned SLocOffset) const {
   // Convert "I" back into an index.  We know that it is an entry whose index is
   // larger than the offset we are looking for.
   unsigned GreaterIndex = I - LocalSLocEntryTable.begin();
+
+  // Narrow the search down to the entries that start within the page of
+  // SLocOffset: the entry containing it is at least the one containing the
+  // start of the page, and at most the one containing the start of the next.
+  updateLocalSLocPageIndex();
+  unsigned Page = SLocOffset >> SLocPageShift;
   // LessIndex - This is the lower bound of the range that we're searching.
   // We know that the offset corresponding to the FileID is is less than
   // SLocOffset.
-  unsigned LessIndex = 0;
+  unsigned LessIndex = LocalSLocPageIndex[Page];
+  if (Page + 1 < LocalSLocPageIndex.size())
+    GreaterIndex = std::min(GreaterIndex, LocalSLocPageIndex[Page + 1] + 1);
+  ++NumPageLookups;
   NumProbes = 0;
   while (1) {
     bool Invalid = false;
@@ -783,6 +811,23 @@ FileID SourceManager::getFileIDLocal(unsigned SLocOffset) const {
   }
 }
 
+/// \brief Extend LocalSLocPageIndex to cover all pages below NextLocalOffset.
+void SourceManager::updateLocalSLocPageIndex() const {
+  unsigned NumPages = ((NextLocalOffset - 1) >> SLocPageShift) + 1;
+  if (LocalSLocPageIndex.size() >= NumPages)
+    return;
+
+  unsigned Index = LocalSLocPageIndex.empty() ? 0 : LocalSLocPageIndex.back();
+  LocalSLocPageIndex.reserve(NumPages);
+  for (unsigned Page = LocalSLocPageIndex.size(); Page != NumPages; ++Page) {
+    unsigned PageStart = Page << SLocPageShift;
+    while (Index + 1 < LocalSLocEntryTable.size() &&
+           LocalSLocEntryTable[Index + 1].getOffset() <= PageStart)
+      ++Index;
+    LocalSLocPageIndex.push_back(Index);
+  }
+}
+
 /// \brief Return the FileID for a SourceLocation with a high offset.
 ///
 /// This function knows that the SourceLocation is in a loaded buffer, not a
@@ -824,6 +869,19 @@ FileID SourceManager::getFileIDLoaded(unsigned SLocOffset) const {
   // actually a lower index!
   unsigned GreaterIndex = I;
   unsigned LessIndex = LoadedSLocEntryTable.size();
+
+  // Only search the block of entries allocated together with the one we are
+  // looking for, so that we don't deserialize entries of other modules. The
+  // blocks are sorted by decreasing offset.
+  auto Allocation = std::partition_point(
+      LoadedSLocAllocations.begin(), LoadedSLocAllocations.end(),
+      [&](const LoadedSLocAllocation &A) { return A.BaseOffset > SLocOffset; });
+  if (Allocation != LoadedSLocAllocations.end()) {
+    GreaterIndex = std::max(GreaterIndex, Allocation->BaseIndex);
+    if (Allocation + 1 != LoadedSLocAllocations.end())
+      LessIndex = std::min(LessIndex, (Allocation + 1)->BaseIndex);
+    ++NumPageLookups;
+  }
   NumProbes = 0;
   while (1) {
     ++NumProbes;
@@ -2134,7 +2192,8 @@ void SourceManager::PrintStats() const {
                << NumLineNumsComputed << " files with line #'s computed, "
                << NumMacroArgsComputed << " files with macro args computed.\n";
   llvm::errs() << "FileID scans: " << NumLinearScans << " linear, "
-               << NumBinaryProbes << " binary.\n";
+               << NumBinaryProbes << " binary, " << NumPageLookups
+               << " narrowed by page.\n";
 }
 
 LLVM_DUMP_METHOD void SourceManager::dump() const {
@@ -299,6 +299,34 @@ bool ContinuationIndenter::mustBreak(const LineState &State) {
   return false;
 }
 
+unsigned
+ContinuationIndenter::getPenaltyLowerBound(const LineState &State) const {
+  unsigned ColumnLimit = getColumnLimit(State);
+  unsigned Column = State.Column;
+  unsigned Penalty = 0;
+  for (const FormatToken *Current = State.NextToken; Current;
+       Current = Current->Next) {
+    if (Current->CanBreakBefore || Current->MustBreakBefore ||
+        Current->closesBlockOrBlockTypeList(Style))
+      break;
+    // Stop at tokens that can be broken themselves, whose width is not known
+    // up front or that are placed together with nested blocks or lists.
+    if (Current->IsMultiline || Current->isStringLiteral() ||
+        Current->isOneOf(tok::comment, TT_ImplicitStringLiteral,
+                         TT_TemplateString) ||
+        !Current->Children.empty() || Current->Role ||
+        (Current->Previous && (!Current->Previous->Children.empty() ||
+                               Current->Previous->Role)))
+      break;
+    // Every token ending beyond the column limit is penalized when it is
+    // added, see moveStateToNextToken().
+    Column += Current->SpacesRequiredBefore + Current->ColumnWidth;
+    if (Column > ColumnLimit)
+      Penalty += Style.PenaltyExcessCharacter * (Column - ColumnLimit);
+  }
+  return Penalty;
+}
+
 unsigned ContinuationIndenter::addTokenToState(LineState &State, bool Newline,
                                                bool DryRun,
                                                unsigned ExtraSpaces) {
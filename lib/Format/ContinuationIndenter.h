@@ -19,6 +19,7 @@
 #include "Encoding.h"
 #include "FormatToken.h"
 #include "clang/Format/Format.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/Support/Regex.h"
 
 namespace clang {
@@ -71,6 +72,14 @@ public:
   /// limit, potentially reduced for preprocessor definitions.
   unsigned getColumnLimit(const LineState &State) const;
 
+  /// \brief Returns a lower bound of the penalty for placing the remaining
+  /// tokens of \p State's line.
+  ///
+  /// The tokens up to the next possible line break have to be placed on the
+  /// current line, so the column limit violations they cause cannot be
+  /// avoided.
+  unsigned getPenaltyLowerBound(const LineState &State) const;
+
 private:
   /// \brief Mark the next token as consumed in \p State and modify its stacks
   /// accordingly.
@@ -303,8 +312,26 @@ struct ParenState {
       return NestedBlockInlined;
     return false;
   }
+
+  bool operator==(const ParenState &Other) const {
+    return !(*this < Other) && !(Other < *this);
+  }
 };
 
+/// \brief Hashes the members of a \c ParenState that \c operator< compares.
+inline llvm::hash_code hash_value(const ParenState &State) {
+  return llvm::hash_combine(
+      State.Indent, State.LastSpace, State.NestedBlockIndent,
+      State.FirstLessLess, bool(State.BreakBeforeClosingBrace),
+      State.QuestionColumn, bool(State.AvoidBinPacking),
+      bool(State.BreakBeforeParameter), bool(State.NoLineBreak),
+      bool(State.LastOperatorWrapped), State.ColonPos,
+      State.StartOfFunctionCall, State.StartOfArraySubscripts,
+      State.CallContinuation, State.VariablePos,
+      bool(State.ContainsLineBreak), bool(State.ContainsUnwrappedBuilder),
+      bool(State.NestedBlockInlined));
+}
+
 /// \brief The current state when indenting a unwrapped line.
 ///
 /// As the indenting tries different combinations this is copied by value.
@@ -374,6 +401,25 @@ struct LineState {
       return false;
     return Stack < Other.Stack;
   }
+
+  /// \brief Returns \c true if neither state compares less than the other
+  /// when their stacks are ignored.
+  bool equalsIgnoringStack(const LineState &Other) const {
+    return NextToken == Other.NextToken && Column == Other.Column &&
+           LineContainsContinuedForLoopSection ==
+               Other.LineContainsContinuedForLoopSection &&
+           StartOfLineLevel == Other.StartOfLineLevel &&
+           LowestLevelOnLine == Other.LowestLevelOnLine &&
+           StartOfStringLiteral == Other.StartOfStringLiteral;
+  }
+
+  /// \brief Hashes the members compared by \c equalsIgnoringStack().
+  llvm::hash_code hashIgnoringStack() const {
+    return llvm::hash_combine(NextToken, Column,
+                              LineContainsContinuedForLoopSection,
+                              StartOfLineLevel, LowestLevelOnLine,
+                              StartOfStringLiteral);
+  }
 };
 
 } // end namespace format
@@ -9,11 +9,24 @@
 
 #include "UnwrappedLineFormatter.h"
 #include "WhitespaceManager.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/Timer.h"
+#include <algorithm>
 #include <queue>
 
 #define DEBUG_TYPE "format-formatter"
 
+STATISTIC(NumLineSolutionsReused,
+          "Number of lines formatted with the solution of an identical line");
+STATISTIC(NumLineSolutionsRejected,
+          "Number of memoized line solutions rejected by their penalty");
+STATISTIC(NumLinesSolved, "Number of lines formatted by the line-breaking "
+                          "search");
+
 namespace clang {
 namespace format {
 
@@ -618,6 +631,61 @@ public:
   }
 };
 
+/// \brief Computes a signature of \p Line starting at \p FirstIndent that
+/// captures the properties of its tokens the line-breaking search depends on.
+///
+/// Literals are part of the signature with their spelling, as breaks are
+/// forced after literals ending in a newline and string literals can be
+/// broken based on their contents.
+///
+/// Returns \c false if the line cannot be formatted like another line with
+/// the same signature, e.g. because it contains comments or nested blocks
+/// that are reflowed or formatted based on their contents.
+static bool getLineSignature(const AnnotatedLine &Line, unsigned FirstIndent,
+                             SmallVectorImpl<char> &Signature) {
+  auto Add = [&](uintptr_t Value) {
+    const char *Bytes = reinterpret_cast<const char *>(&Value);
+    Signature.append(Bytes, Bytes + sizeof(Value));
+  };
+  auto AddText = [&](StringRef Text) {
+    Add(Text.size());
+    Signature.append(Text.begin(), Text.end());
+  };
+  Signature.clear();
+  Add(FirstIndent);
+  Add(Line.Type);
+  Add(Line.Level);
+  Add(Line.InPPDirective);
+  Add(Line.MustBeDeclaration);
+  for (const FormatToken *Tok = Line.First; Tok; Tok = Tok->Next) {
+    if (Tok->is(tok::comment) || Tok->IsMultiline || !Tok->Children.empty())
+      return false;
+    Add(Tok->Tok.getKind());
+    Add(Tok->Type);
+    // Identifiers and keywords influence the formatting by their identity,
+    // e.g. through AdditionalKeywords.
+    Add(reinterpret_cast<uintptr_t>(Tok->Tok.getIdentifierInfo()));
+    if (Tok->Tok.isLiteral())
+      AddText(Tok->TokenText);
+    Add(Tok->ColumnWidth);
+    Add(Tok->SpacesRequiredBefore);
+    Add(Tok->CanBreakBefore);
+    Add(Tok->MustBreakBefore);
+    Add(Tok->SplitPenalty);
+    Add(Tok->NestingLevel);
+    Add(Tok->BlockKind);
+    Add(Tok->PackingKind);
+    Add(Tok->ParameterCount);
+    Add(Tok->Decision);
+    Add(Tok->LongestObjCSelectorName);
+    Add(Tok->FakeRParens);
+    Add(Tok->FakeLParens.size());
+    for (prec::Level Precedence : Tok->FakeLParens)
+      Add(Precedence);
+  }
+  return true;
+}
+
 /// \brief Finds the best way to break lines.
 class OptimizingLineFormatter : public LineFormatter {
 public:
@@ -638,14 +706,53 @@ public:
     if (State.Line->Type == LT_ObjCMethodDecl)
       State.Stack.back().BreakBeforeParameter = true;
 
+    // Lines that look the same to the search get the same line breaks, so
+    // reuse the solution of an earlier identical line if there is one.
+    SmallString<256> Signature;
+    if (!getLineSignature(Line, FirstIndent, Signature))
+      return analyzeSolutionSpace(State, DryRun);
+    if (const UnwrappedLineFormatter::LineSolution *Solution =
+            BlockFormatter->getLineSolution(Signature)) {
+      if (replaySolution(State, *Solution, DryRun)) {
+        ++NumLineSolutionsReused;
+        return Solution->Penalty;
+      }
+      ++NumLineSolutionsRejected;
+    }
+
     // Find best solution in solution space.
-    return analyzeSolutionSpace(State, DryRun);
+    UnwrappedLineFormatter::LineSolution Solution;
+    Solution.Penalty = analyzeSolutionSpace(State, DryRun, &Solution);
+    if (Solution.NewLines.size() + 1 == countTokens(Line))
+      BlockFormatter->addLineSolution(Signature, std::move(Solution));
+    return Solution.Penalty;
   }
 
 private:
-  struct CompareLineStatePointers {
-    bool operator()(LineState *obj1, LineState *obj2) const {
-      return *obj1 < *obj2;
+  /// \brief Hashes and compares \c LineState pointers by the states they
+  /// point to, with or without their \c ParenState stacks.
+  template <bool IgnoreStack> struct LineStatePointerInfo {
+    static LineState *getEmptyKey() {
+      return llvm::DenseMapInfo<LineState *>::getEmptyKey();
+    }
+    static LineState *getTombstoneKey() {
+      return llvm::DenseMapInfo<LineState *>::getTombstoneKey();
+    }
+    static unsigned getHashValue(const LineState *State) {
+      if (IgnoreStack)
+        return State->hashIgnoringStack();
+      return llvm::hash_combine(
+          State->hashIgnoringStack(),
+          llvm::hash_combine_range(State->Stack.begin(), State->Stack.end()));
+    }
+    static bool isEqual(const LineState *LHS, const LineState *RHS) {
+      if (LHS == RHS)
+        return true;
+      if (LHS == getEmptyKey() || LHS == getTombstoneKey() ||
+          RHS == getEmptyKey() || RHS == getTombstoneKey())
+        return false;
+      return LHS->equalsIgnoringStack(*RHS) &&
+             (IgnoreStack || LHS->Stack == RHS->Stack);
     }
   };
 
@@ -664,6 +771,11 @@ private:
     LineState State;
     bool NewLine;
     StateNode *Previous;
+    /// \brief The penalty of the path from the initial state to \c State.
+    unsigned Penalty = 0;
+    /// \brief The lower bound of the penalty of completing the line from
+    /// \c State.
+    unsigned PenaltyLowerBound = 0;
   };
 
   /// \brief An item in the prioritized BFS search queue. The \c StateNode's
@@ -681,18 +793,38 @@ private:
   /// find the shortest path (the one with lowest penalty) from \p InitialState
   /// to a state where all tokens are placed. Returns the penalty.
   ///
-  /// If \p DryRun is \c false, directly applies the changes.
-  unsigned analyzeSolutionSpace(LineState &InitialState, bool DryRun) {
-    std::set<LineState *, CompareLineStatePointers> Seen;
+  /// States whose penalty plus \c ContinuationIndenter::getPenaltyLowerBound
+  /// exceeds the penalty of the solution found by \c getGreedyPenalty are not
+  /// queued: they cannot lead to a better solution. As the bound never
+  /// overestimates, no state on the path of a best solution is dropped, and
+  /// the remaining states are examined in the same order as without the
+  /// bound, so the same solution is picked among those of equal penalty.
+  ///
+  /// If \p DryRun is \c false, directly applies the changes. If \p Solution
+  /// is non-null, its line break decisions and columns are set to those of
+  /// the solution.
+  unsigned
+  analyzeSolutionSpace(LineState &InitialState, bool DryRun,
+                       UnwrappedLineFormatter::LineSolution *Solution =
+                           nullptr) {
+    // The states examined so far. Once the analysis gets too complex, states
+    // are only compared ignoring their stacks, see IgnoreStackForComparison.
+    llvm::DenseSet<LineState *, LineStatePointerInfo<false>> Seen;
+    llvm::DenseSet<LineState *, LineStatePointerInfo<true>> SeenIgnoringStack;
+    unsigned NumExamined = 0;
+    llvm::TimeRecord StartTime;
+    DEBUG(StartTime = llvm::TimeRecord::getCurrentTime());
 
     // Increasing count of \c StateNode items we have created. This is used to
     // create a deterministic order independent of the container.
     unsigned Count = 0;
     QueueType Queue;
+    unsigned MaxPenalty = getGreedyPenalty(InitialState);
 
     // Insert start element into queue.
     StateNode *Node =
         new (Allocator.Allocate()) StateNode(InitialState, false, nullptr);
+    Node->PenaltyLowerBound = Indenter->getPenaltyLowerBound(Node->State);
     Queue.push(QueueItem(OrderedPenalty(0, Count), Node));
     ++Count;
 
@@ -700,9 +832,11 @@ private:
 
     // While not empty, take first element and follow edges.
     while (!Queue.empty()) {
-      Penalty = Queue.top().first.first;
       StateNode *Node = Queue.top().second;
+      Penalty = Node->Penalty;
       if (!Node->State.NextToken) {
+        assert(Node->PenaltyLowerBound == 0 &&
+               "Lower bound of a complete line must be zero");
         DEBUG(llvm::dbgs() << "\n---\nPenalty for line: " << Penalty << "\n");
         break;
       }
@@ -713,15 +847,21 @@ private:
       if (Count > 50000)
         Node->State.IgnoreStackForComparison = true;
 
-      if (!Seen.insert(&Node->State).second)
+      bool NewIgnoringStack = SeenIgnoringStack.insert(&Node->State).second;
+      if (Node->State.IgnoreStackForComparison
+              ? !NewIgnoringStack
+              : !Seen.insert(&Node->State).second)
         // State already examined with lower penalty.
         continue;
+      ++NumExamined;
 
       FormatDecision LastFormat = Node->State.NextToken->Decision;
       if (LastFormat == FD_Unformatted || LastFormat == FD_Continue)
-        addNextStateToQueue(Penalty, Node, /*NewLine=*/false, &Count, &Queue);
+        addNextStateToQueue(Penalty, Node, /*NewLine=*/false, MaxPenalty,
+                            &Count, &Queue);
       if (LastFormat == FD_Unformatted || LastFormat == FD_Break)
-        addNextStateToQueue(Penalty, Node, /*NewLine=*/true, &Count, &Queue);
+        addNextStateToQueue(Penalty, Node, /*NewLine=*/true, MaxPenalty,
+                            &Count, &Queue);
     }
 
     if (Queue.empty()) {
@@ -731,11 +871,31 @@ private:
       return 0;
     }
 
+    ++NumLinesSolved;
+
     // Reconstruct the solution.
+    if (Solution) {
+      Solution->NewLines.clear();
+      Solution->Columns.clear();
+      for (StateNode *Node = Queue.top().second; Node->Previous;
+           Node = Node->Previous) {
+        Solution->NewLines.push_back(Node->NewLine);
+        Solution->Columns.push_back(Node->State.Column);
+      }
+      std::reverse(Solution->NewLines.begin(), Solution->NewLines.end());
+      std::reverse(Solution->Columns.begin(), Solution->Columns.end());
+    }
     if (!DryRun)
       reconstructPath(InitialState, Queue.top().second);
 
-    DEBUG(llvm::dbgs() << "Total number of analyzed states: " << Count << "\n");
+    DEBUG({
+      llvm::TimeRecord Elapsed = llvm::TimeRecord::getCurrentTime();
+      Elapsed -= StartTime;
+      llvm::dbgs() << "Total number of analyzed states: " << Count << " ("
+                   << NumExamined << " examined) in "
+                   << llvm::format("%.3f", Elapsed.getWallTime() * 1000)
+                   << " ms\n";
+    });
     DEBUG(llvm::dbgs() << "---\n");
 
     return Penalty;
@@ -745,8 +905,11 @@ private:
   ///
   /// Assume the current state is \p PreviousNode and has been reached with a
   /// penalty of \p Penalty. Insert a line break if \p NewLine is \c true.
+  /// The state is dropped if every solution through it has a penalty above
+  /// \p MaxPenalty.
   void addNextStateToQueue(unsigned Penalty, StateNode *PreviousNode,
-                           bool NewLine, unsigned *Count, QueueType *Queue) {
+                           bool NewLine, unsigned MaxPenalty, unsigned *Count,
+                           QueueType *Queue) {
     if (NewLine && !Indenter->canBreak(PreviousNode->State))
       return;
     if (!NewLine && Indenter->mustBreak(PreviousNode->State))
@@ -758,11 +921,74 @@ private:
       return;
 
     Penalty += Indenter->addTokenToState(Node->State, NewLine, true);
+    Node->Penalty = Penalty;
+    Node->PenaltyLowerBound = Indenter->getPenaltyLowerBound(Node->State);
+    // The bound has to be consistent, i.e. no step may lower the estimate;
+    // together with a zero bound for complete lines that makes it never
+    // overestimate, so the search still finds a solution of minimal penalty.
+    assert(Node->Penalty + Node->PenaltyLowerBound >=
+               PreviousNode->Penalty + PreviousNode->PenaltyLowerBound &&
+           "Penalty lower bound is not consistent");
+    if (Penalty + Node->PenaltyLowerBound > MaxPenalty)
+      return;
 
     Queue->push(QueueItem(OrderedPenalty(Penalty, *Count), Node));
     ++(*Count);
   }
 
+  /// \brief Returns the penalty of the solution that only breaks before a
+  /// token that would otherwise end beyond the column limit, or \c UINT_MAX
+  /// if that does not lead to a solution.
+  ///
+  /// This is an upper bound of the penalty of the best solution, which lets
+  /// \c analyzeSolutionSpace drop states that cannot be part of it.
+  unsigned getGreedyPenalty(const LineState &InitialState) {
+    LineState State = InitialState;
+    unsigned Penalty = 0;
+    while (State.NextToken) {
+      FormatDecision LastFormat = State.NextToken->Decision;
+      bool CanContinue =
+          (LastFormat == FD_Unformatted || LastFormat == FD_Continue) &&
+          !Indenter->mustBreak(State);
+      bool CanBreak = (LastFormat == FD_Unformatted || LastFormat == FD_Break) &&
+                      Indenter->canBreak(State);
+
+      LineState Continued = State;
+      unsigned ContinuedPenalty = Penalty;
+      if (CanContinue) {
+        CanContinue = formatChildren(Continued, /*NewLine=*/false,
+                                     /*DryRun=*/true, ContinuedPenalty);
+        if (CanContinue) {
+          ContinuedPenalty +=
+              Indenter->addTokenToState(Continued, /*NewLine=*/false, true);
+          if (Style.ColumnLimit == 0 ||
+              Continued.Column <= Indenter->getColumnLimit(Continued)) {
+            State = Continued;
+            Penalty = ContinuedPenalty;
+            continue;
+          }
+        }
+      }
+
+      if (CanBreak) {
+        LineState Broken = State;
+        unsigned BrokenPenalty = Penalty;
+        if (formatChildren(Broken, /*NewLine=*/true, /*DryRun=*/true,
+                           BrokenPenalty)) {
+          State = Broken;
+          Penalty = BrokenPenalty +
+                    Indenter->addTokenToState(State, /*NewLine=*/true, true);
+          continue;
+        }
+      }
+      if (!CanContinue)
+        return UINT_MAX;
+      State = Continued;
+      Penalty = ContinuedPenalty;
+    }
+    return Penalty;
+  }
+
   /// \brief Applies the best formatting by reconstructing the path in the
   /// solution space that leads to \c Best.
   void reconstructPath(LineState &State, StateNode *Best) {
@@ -789,6 +1015,64 @@ private:
     }
   }
 
+  static unsigned countTokens(const AnnotatedLine &Line) {
+    unsigned Count = 0;
+    for (const FormatToken *Tok = Line.First; Tok; Tok = Tok->Next)
+      ++Count;
+    return Count;
+  }
+
+  /// \brief Places the tokens after \p State according to \p NewLines.
+  ///
+  /// Returns \c false if one of the decisions is not allowed, i.e. if it
+  /// breaks where \c ContinuationIndenter::canBreak does not allow it or
+  /// does not break where \c ContinuationIndenter::mustBreak requires it, if
+  /// the number of decisions does not match the number of tokens, or if
+  /// \p Columns is not empty and a token does not end at the given column.
+  bool applyLineBreaks(LineState &State, const std::vector<bool> &NewLines,
+                       bool DryRun, unsigned &Penalty,
+                       ArrayRef<unsigned> Columns = None) {
+    for (unsigned I = 0, E = NewLines.size(); I != E; ++I) {
+      bool NewLine = NewLines[I];
+      if (!State.NextToken)
+        return false;
+      if (NewLine ? !Indenter->canBreak(State) : Indenter->mustBreak(State))
+        return false;
+      if (!formatChildren(State, NewLine, DryRun, Penalty))
+        return false;
+      Penalty += Indenter->addTokenToState(State, NewLine, DryRun);
+      if (!Columns.empty() && State.Column != Columns[I])
+        return false;
+    }
+    return !State.NextToken;
+  }
+
+  /// \brief Formats the line starting at \p State with the line breaks of
+  /// \p Solution, which was found for a line with the same signature.
+  ///
+  /// The solution is first tried in a dry run and rejected if one of its
+  /// decisions is not allowed for this line (see \c applyLineBreaks), if it
+  /// does not place exactly the tokens of this line, if it places a token at
+  /// a different column, i.e. would produce different whitespace, than for
+  /// the line it was found for, or if it results in a different penalty.
+  /// Each of these means that the signature missed a difference between the
+  /// lines.
+  bool replaySolution(LineState &State,
+                      const UnwrappedLineFormatter::LineSolution &Solution,
+                      bool DryRun) {
+    LineState DryRunState = State;
+    unsigned Penalty = 0;
+    if (!applyLineBreaks(DryRunState, Solution.NewLines, /*DryRun=*/true,
+                         Penalty, Solution.Columns) ||
+        Penalty != Solution.Penalty)
+      return false;
+    if (DryRun)
+      return true;
+    Penalty = 0;
+    applyLineBreaks(State, Solution.NewLines, /*DryRun=*/false, Penalty);
+    return true;
+  }
+
   llvm::SpecificBumpPtrAllocator<StateNode> Allocator;
 };
 
@@ -18,7 +18,9 @@
 
 #include "ContinuationIndenter.h"
 #include "clang/Format/Format.h"
+#include "llvm/ADT/StringMap.h"
 #include <map>
+#include <vector>
 
 namespace clang {
 namespace format {
@@ -43,6 +45,29 @@ public:
                   bool DryRun = false, int AdditionalIndent = 0,
                   bool FixBadIndentation = false);
 
+  /// \brief The line breaks chosen for a line by the line-breaking search.
+  struct LineSolution {
+    /// \brief Whether each token after the first one starts a new line.
+    std::vector<bool> NewLines;
+    /// \brief The column after each token after the first one. Together with
+    /// \c NewLines and the token widths, which are part of the signature,
+    /// these determine the whitespace the solution produces.
+    std::vector<unsigned> Columns;
+    unsigned Penalty;
+  };
+
+  /// \brief Returns the solution recorded for lines with \p Signature, or
+  /// null if there is none.
+  const LineSolution *getLineSolution(StringRef Signature) const {
+    auto Known = LineSolutions.find(Signature);
+    return Known == LineSolutions.end() ? nullptr : &Known->second;
+  }
+
+  /// \brief Records the solution found for a line with \p Signature.
+  void addLineSolution(StringRef Signature, LineSolution Solution) {
+    LineSolutions[Signature] = std::move(Solution);
+  }
+
 private:
   /// \brief Add a new line and the required indent before the first Token
   /// of the \c UnwrappedLine if there was no structural parsing error.
@@ -61,6 +86,11 @@ private:
            unsigned>
       PenaltyCache;
 
+  // Solutions of the line-breaking search, keyed by a signature of the
+  // line's tokens and indent. Generated code often contains many lines that
+  // only differ in their literals, which then only need to be solved once.
+  llvm::StringMap<LineSolution> LineSolutions;
+
   ContinuationIndenter *Indenter;
   WhitespaceManager *Whitespaces;
   const FormatStyle &Style;
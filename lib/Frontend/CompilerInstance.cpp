@@ -377,6 +377,16 @@ void CompilerInstance::createPreprocessor(TranslationUnitKind TUKind) {
   HeaderSearch *HeaderInfo =
       new HeaderSearch(getHeaderSearchOptsPtr(), getSourceManager(),
                        getDiagnostics(), getLangOpts(), &getTarget());
+  if (getHeaderSearchOpts().UseDirectoryListingCache) {
+    IntrusiveRefCntPtr<DirectoryListingCache> ListingCache =
+        DirectoryListingCache::getProcessCache();
+    // A missing or stale cache file is not an error; it is written back
+    // once the action finishes.
+    if (!getHeaderSearchOpts().DirectoryListingCachePath.empty())
+      ListingCache->loadFromFile(
+          getHeaderSearchOpts().DirectoryListingCachePath);
+    HeaderInfo->setDirectoryListingCache(std::move(ListingCache));
+  }
   PP = std::make_shared<Preprocessor>(
       Invocation->getPreprocessorOptsPtr(), getDiagnostics(), getLangOpts(),
       getSourceManager(), getPCMCache(), *HeaderInfo, *this, PTHMgr,
@@ -977,6 +987,12 @@ bool CompilerInstance::ExecuteAction(FrontendAction &Act) {
     }
   }
 
+  // Save the directory listings read by header search for later
+  // compilations.
+  if (!getHeaderSearchOpts().DirectoryListingCachePath.empty())
+    DirectoryListingCache::getProcessCache()->writeToFile(
+        getHeaderSearchOpts().DirectoryListingCachePath);
+
   // Notify the diagnostic client that all files were processed.
   getDiagnostics().getClient()->finish();
 
@@ -1015,6 +1031,23 @@ bool CompilerInstance::ExecuteAction(FrontendAction &Act) {
       llvm::PrintStatisticsJSON(*StatS);
     }
   }
+  StringRef MemoryStatsFile = getFrontendOpts().MemoryStatsFile;
+  if (!MemoryStatsFile.empty()) {
+    // One entry per input, so that no input overwrites the breakdown of
+    // another.
+    std::error_code EC;
+    llvm::raw_fd_ostream MemS(MemoryStatsFile, EC, llvm::sys::fs::F_Text);
+    if (EC) {
+      getDiagnostics().Report(diag::warn_fe_unable_to_open_stats_file)
+          << MemoryStatsFile << EC.message();
+    } else {
+      MemS << "[";
+      for (unsigned I = 0, N = MemoryStats.size(); I != N; ++I)
+        MemS << (I ? ",\n" : "\n") << MemoryStats[I];
+      MemS << "\n]\n";
+    }
+    MemoryStats.clear();
+  }
 
   return !getDiagnostics().getClient()->getNumErrors();
 }
@@ -0,0 +1,134 @@
+//===--- DeduplicatingDiagnosticConsumer.cpp - Drop repeated diags --------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Frontend/DeduplicatingDiagnosticConsumer.h"
+#include "clang/Basic/IdentifierTable.h"
+#include "clang/Basic/SourceManager.h"
+
+using namespace clang;
+
+bool DiagnosticDeduplicationSet::insert(StringRef Key) {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  if (Seen.insert(Key).second)
+    return true;
+  ++NumDuplicates;
+  return false;
+}
+
+unsigned DiagnosticDeduplicationSet::getNumUnique() {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  return Seen.size();
+}
+
+unsigned DiagnosticDeduplicationSet::getNumDuplicates() {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  return NumDuplicates;
+}
+
+DeduplicatingDiagnosticConsumer::DeduplicatingDiagnosticConsumer(
+    std::unique_ptr<DiagnosticConsumer> Target,
+    IntrusiveRefCntPtr<DiagnosticDeduplicationSet> Seen)
+    : OwningTarget(std::move(Target)), Target(OwningTarget.get()),
+      Seen(std::move(Seen)) {
+  if (!this->Seen)
+    this->Seen = new DiagnosticDeduplicationSet();
+}
+
+DeduplicatingDiagnosticConsumer::DeduplicatingDiagnosticConsumer(
+    DiagnosticConsumer *Target,
+    IntrusiveRefCntPtr<DiagnosticDeduplicationSet> Seen)
+    : Target(Target), Seen(std::move(Seen)) {
+  if (!this->Seen)
+    this->Seen = new DiagnosticDeduplicationSet();
+}
+
+DeduplicatingDiagnosticConsumer::~DeduplicatingDiagnosticConsumer() {}
+
+static void addToKey(SmallVectorImpl<char> &Key, uint64_t Value) {
+  const char *Bytes = reinterpret_cast<const char *>(&Value);
+  Key.append(Bytes, Bytes + sizeof(Value));
+}
+
+static void addToKey(SmallVectorImpl<char> &Key, StringRef Str) {
+  addToKey(Key, Str.size());
+  Key.append(Str.begin(), Str.end());
+}
+
+/// \brief Build the key identifying a diagnostic across translation units.
+///
+/// Locations are identified by the file they expand into and their offset in
+/// it, which does not depend on the translation unit. Arguments are encoded
+/// as they are, except for arguments referring to AST nodes, which are only
+/// meaningful within one translation unit; diagnostics with such arguments
+/// are identified by their formatted text instead.
+static void getDiagnosticKey(DiagnosticsEngine::Level DiagLevel,
+                             const Diagnostic &Info,
+                             SmallVectorImpl<char> &Key) {
+  Key.clear();
+  addToKey(Key, Info.getID());
+  addToKey(Key, DiagLevel);
+
+  SourceLocation Loc = Info.getLocation();
+  if (Loc.isValid() && Info.hasSourceManager()) {
+    const SourceManager &SM = Info.getSourceManager();
+    std::pair<FileID, unsigned> Decomposed = SM.getDecomposedExpansionLoc(Loc);
+    if (const FileEntry *File = SM.getFileEntryForID(Decomposed.first)) {
+      addToKey(Key, File->getUniqueID().getDevice());
+      addToKey(Key, File->getUniqueID().getFile());
+    } else {
+      addToKey(Key, SM.getBufferName(Loc));
+    }
+    addToKey(Key, Decomposed.second);
+  }
+
+  for (unsigned I = 0, N = Info.getNumArgs(); I != N; ++I) {
+    DiagnosticsEngine::ArgumentKind Kind = Info.getArgKind(I);
+    addToKey(Key, Kind);
+    switch (Kind) {
+    case DiagnosticsEngine::ak_std_string:
+      addToKey(Key, Info.getArgStdStr(I));
+      break;
+    case DiagnosticsEngine::ak_c_string:
+      addToKey(Key, Info.getArgCStr(I));
+      break;
+    case DiagnosticsEngine::ak_sint:
+      addToKey(Key, Info.getArgSInt(I));
+      break;
+    case DiagnosticsEngine::ak_uint:
+      addToKey(Key, Info.getArgUInt(I));
+      break;
+    case DiagnosticsEngine::ak_identifierinfo: {
+      const IdentifierInfo *II = Info.getArgIdentifier(I);
+      addToKey(Key, II ? II->getName() : StringRef());
+      break;
+    }
+    default: {
+      SmallString<128> Text;
+      Info.FormatDiagnostic(Text);
+      addToKey(Key, Text);
+      return;
+    }
+    }
+  }
+}
+
+void DeduplicatingDiagnosticConsumer::HandleDiagnostic(
+    DiagnosticsEngine::Level DiagLevel, const Diagnostic &Info) {
+  // Default implementation (Warnings/errors count).
+  DiagnosticConsumer::HandleDiagnostic(DiagLevel, Info);
+
+  if (DiagLevel != DiagnosticsEngine::Note) {
+    getDiagnosticKey(DiagLevel, Info, Key);
+    DroppingNotes = !Seen->insert(Key);
+  }
+  if (DroppingNotes)
+    return;
+
+  Target->HandleDiagnostic(DiagLevel, Info);
+}
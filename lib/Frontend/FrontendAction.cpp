@@ -11,6 +11,7 @@
 #include "clang/AST/ASTConsumer.h"
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/DeclGroup.h"
+#include "clang/AST/Stmt.h"
 #include "clang/Frontend/ASTUnit.h"
 #include "clang/Frontend/CompilerInstance.h"
 #include "clang/Frontend/FrontendDiagnostic.h"
@@ -23,11 +24,13 @@
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Lex/PreprocessorOptions.h"
 #include "clang/Parse/ParseAST.h"
+#include "clang/Sema/Sema.h"
 #include "clang/Serialization/ASTDeserializationListener.h"
 #include "clang/Serialization/ASTReader.h"
 #include "clang/Serialization/GlobalModuleIndex.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
@@ -907,6 +910,56 @@ bool FrontendAction::Execute() {
   return true;
 }
 
+/// \brief Print \p Str as a JSON string literal. Bytes outside of ASCII are
+/// printed as they are, so that UTF-8 text stays valid.
+static void printJSONString(raw_ostream &OS, StringRef Str) {
+  OS << '"';
+  for (unsigned char C : Str) {
+    switch (C) {
+    case '"':  OS << "\\\""; break;
+    case '\\': OS << "\\\\"; break;
+    case '\b': OS << "\\b"; break;
+    case '\f': OS << "\\f"; break;
+    case '\n': OS << "\\n"; break;
+    case '\r': OS << "\\r"; break;
+    case '\t': OS << "\\t"; break;
+    default:
+      if (C < 0x20)
+        OS << "\\u" << llvm::format_hex_no_prefix(C, 4);
+      else
+        OS << C;
+      break;
+    }
+  }
+  OS << '"';
+}
+
+/// \brief Add the memory breakdown of the AST and Sema of the translation
+/// unit \p File to those written to the -memory-stats-file.
+static void recordMemoryStats(CompilerInstance &CI, StringRef File) {
+  std::string Stats;
+  llvm::raw_string_ostream OS(Stats);
+  OS << "{\n\t\"file\": ";
+  printJSONString(OS, File);
+  OS << ",\n\t\"ast\": ";
+  CI.getASTContext().printMemoryStatsJSON(OS);
+  OS << ",\n\t\"decls_by_kind\": ";
+  Decl::PrintStatsJSON(OS);
+  OS << ",\n\t\"types_by_kind\": ";
+  CI.getASTContext().printTypeStatsJSON(OS);
+  OS << ",\n\t\"stmts_by_kind\": ";
+  Stmt::PrintStatsJSON(OS);
+  if (CI.hasSema())
+    OS << ",\n\t\"sema_arena\": " << CI.getSema().BumpAlloc.getTotalMemory();
+  OS << "\n}";
+  CI.addMemoryStats(std::move(OS.str()));
+
+  // The declarations and statements of each kind are counted globally; start
+  // the counts of the next translation unit from zero.
+  Decl::ResetStatistics();
+  Stmt::ResetStatistics();
+}
+
 void FrontendAction::EndSourceFile() {
   CompilerInstance &CI = getCompilerInstance();
 
@@ -920,6 +973,9 @@ void FrontendAction::EndSourceFile() {
   // Finalize the action.
   EndSourceFileAction();
 
+  if (!CI.getFrontendOpts().MemoryStatsFile.empty() && CI.hasASTContext())
+    recordMemoryStats(CI, getCurrentFile());
+
   // Sema references the ast consumer, so reset sema first.
   //
   // FIXME: There is more per-file stuff we could just drop here?
@@ -992,8 +1048,16 @@ void ASTFrontendAction::ExecuteAction() {
   if (!CI.hasSema())
     CI.createSema(getTranslationUnitKind(), CompletionConsumer);
 
-  ParseAST(CI.getSema(), CI.getFrontendOpts().ShowStats,
-           CI.getFrontendOpts().SkipFunctionBodies);
+  const FrontendOptions &FEOpts = CI.getFrontendOpts();
+  CI.getSema().DeclarationsOnly = FEOpts.ParseDeclarationsOnly;
+
+  // The memory breakdown counts the declarations and statements of each kind.
+  if (!FEOpts.MemoryStatsFile.empty()) {
+    Decl::EnableStatistics();
+    Stmt::EnableStatistics();
+  }
+  ParseAST(CI.getSema(), FEOpts.ShowStats,
+           FEOpts.SkipFunctionBodies || FEOpts.ParseDeclarationsOnly);
 }
 
 void PluginASTAction::anchor() { }
@@ -96,7 +96,9 @@ GeneratePCHAction::CreateASTConsumer(CompilerInstance &CI, StringRef InFile) {
                         Buffer, CI.getFrontendOpts().ModuleFileExtensions,
       /*AllowASTWithErrors*/CI.getPreprocessorOpts().AllowPCHWithCompilerErrors,
                         /*IncludeTimestamps*/
-                          +CI.getFrontendOpts().IncludeTimestamps));
+                          +CI.getFrontendOpts().IncludeTimestamps,
+                        /*CompressLookupTables*/
+                          +CI.getFrontendOpts().CompressASTLookupTables));
   Consumers.push_back(CI.getPCHContainerWriter().CreatePCHContainerGenerator(
       CI, InFile, OutputFile, std::move(OS), Buffer));
 
@@ -157,7 +159,9 @@ GenerateModuleAction::CreateASTConsumer(CompilerInstance &CI,
                         Buffer, CI.getFrontendOpts().ModuleFileExtensions,
                         /*AllowASTWithErrors=*/false,
                         /*IncludeTimestamps=*/
-                          +CI.getFrontendOpts().BuildingImplicitModule));
+                          +CI.getFrontendOpts().BuildingImplicitModule,
+                        /*CompressLookupTables=*/
+                          +CI.getFrontendOpts().CompressASTLookupTables));
   Consumers.push_back(CI.getPCHContainerWriter().CreatePCHContainerGenerator(
       CI, InFile, OutputFile, std::move(OS), Buffer));
   return llvm::make_unique<MultiplexConsumer>(std::move(Consumers));
@@ -214,6 +218,11 @@ SyntaxOnlyAction::CreateASTConsumer(CompilerInstance &CI, StringRef InFile) {
   return llvm::make_unique<ASTConsumer>();
 }
 
+bool ParseDeclarationsOnlyAction::BeginInvocation(CompilerInstance &CI) {
+  CI.getFrontendOpts().ParseDeclarationsOnly = true;
+  return true;
+}
+
 std::unique_ptr<ASTConsumer>
 DumpModuleInfoAction::CreateASTConsumer(CompilerInstance &CI,
                                         StringRef InFile) {
@@ -60,6 +60,8 @@ CreateFrontendBaseAction(CompilerInstance &CI) {
   case GeneratePTH:            return llvm::make_unique<GeneratePTHAction>();
   case InitOnly:               return llvm::make_unique<InitOnlyAction>();
   case ParseSyntaxOnly:        return llvm::make_unique<SyntaxOnlyAction>();
+  case ParseDeclarationsOnly:
+    return llvm::make_unique<ParseDeclarationsOnlyAction>();
   case ModuleFileInfo:         return llvm::make_unique<DumpModuleInfoAction>();
   case VerifyPCH:              return llvm::make_unique<VerifyPCHAction>();
 
@@ -0,0 +1,219 @@
+//===--- IndexStoreFormat.h - Index store on-disk format --------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Record files have the following layout, all integers little-endian:
+//
+//   'I' 'D' 'X' 'R'  uint32 version  uint32 table-offset
+//   uint32 path-length  path
+//   on-disk chained hash table mapping USR -> occurrences
+//
+// The hash table is keyed by the low bits of index::hashUSR() of each USR,
+// which the writer gets from its USRCache without hashing the USR string.
+//
+// Unit files have the following layout:
+//
+//   'I' 'D' 'X' 'U'  uint32 version
+//   uint32 path-length  main-file-path
+//   uint32 dependency-count
+//   { uint64 size  uint64 mtime  uint32 path-length  path
+//     uint32 record-name-length  record-name } *
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LIB_INDEX_INDEXSTOREFORMAT_H
+#define LLVM_CLANG_LIB_INDEX_INDEXSTOREFORMAT_H
+
+#include "clang/Basic/LLVM.h"
+#include "clang/Index/IndexSymbol.h"
+#include "clang/Index/USRGeneration.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/OnDiskHashTable.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+#include <tuple>
+#include <vector>
+
+namespace clang {
+namespace index {
+namespace store {
+
+/// \brief The version of the on-disk format. Bump this whenever the layout of
+/// unit or record files changes; readers reject mismatched versions.
+static const unsigned StoreFormatVersion = 2;
+
+static inline StringRef getStoreVersionDirName() { return "v2"; }
+static inline StringRef getUnitsDirName() { return "units"; }
+static inline StringRef getRecordsDirName() { return "records"; }
+
+/// \brief Compute the absolute path used for \p Path in unit and record files.
+static inline void getAbsolutePath(StringRef Path,
+                                   SmallVectorImpl<char> &Result) {
+  Result.assign(Path.begin(), Path.end());
+  llvm::sys::fs::make_absolute(Result);
+  llvm::sys::path::remove_dots(Result, /*remove_dot_dot=*/true);
+}
+
+/// \brief Compute the name of the unit of the translation unit whose main
+/// file has the absolute path \p MainFilePath.
+static inline void getUnitName(StringRef MainFilePath,
+                               SmallVectorImpl<char> &Name) {
+  llvm::MD5 Hash;
+  Hash.update(MainFilePath);
+  llvm::MD5::MD5Result Result;
+  Hash.final(Result);
+  SmallString<32> HexHash;
+  llvm::MD5::stringifyResult(Result, HexHash);
+
+  Name.clear();
+  llvm::raw_svector_ostream OS(Name);
+  OS << llvm::sys::path::filename(MainFilePath) << '-' << HexHash;
+}
+
+static const char RecordMagic[4] = { 'I', 'D', 'X', 'R' };
+static const char UnitMagic[4] = { 'I', 'D', 'X', 'U' };
+
+/// \brief Size of the fixed record file header: magic, version and the
+/// offset of the hash table buckets.
+static const unsigned RecordHeaderSize = 12;
+
+/// \brief An occurrence as stored in a record file; the USR is the key of the
+/// hash table entry it belongs to.
+struct RecordOccurrence {
+  SymbolKind Kind;
+  SymbolRoleSet Roles;
+  unsigned Line;
+  unsigned Column;
+
+  bool operator<(const RecordOccurrence &RHS) const {
+    return std::tie(Line, Column, Kind, Roles) <
+           std::tie(RHS.Line, RHS.Column, RHS.Kind, RHS.Roles);
+  }
+  bool operator==(const RecordOccurrence &RHS) const {
+    return Line == RHS.Line && Column == RHS.Column && Kind == RHS.Kind &&
+           Roles == RHS.Roles;
+  }
+};
+
+/// \brief Number of bytes each \c RecordOccurrence occupies on disk.
+static const unsigned RecordOccurrenceSize = 1 + 4 + 4 + 4;
+
+/// \brief A USR along with its \c index::hashUSR() value.
+struct RecordKey {
+  StringRef USR;
+  USRHash Hash;
+};
+
+/// \brief Trait used to emit the USR -> occurrences table of a record file.
+class RecordWriterTrait {
+public:
+  typedef RecordKey key_type;
+  typedef const RecordKey &key_type_ref;
+  typedef std::vector<RecordOccurrence> data_type;
+  typedef const std::vector<RecordOccurrence> &data_type_ref;
+  typedef unsigned hash_value_type;
+  typedef unsigned offset_type;
+
+  static hash_value_type ComputeHash(key_type_ref Key) {
+    return static_cast<hash_value_type>(Key.Hash.Low);
+  }
+
+  std::pair<unsigned, unsigned>
+  EmitKeyDataLength(raw_ostream &Out, key_type_ref Key, data_type_ref Data) {
+    using namespace llvm::support;
+    endian::Writer<little> LE(Out);
+    unsigned KeyLen = Key.USR.size();
+    unsigned DataLen = Data.size() * RecordOccurrenceSize;
+    LE.write<uint32_t>(KeyLen);
+    LE.write<uint32_t>(DataLen);
+    return std::make_pair(KeyLen, DataLen);
+  }
+
+  void EmitKey(raw_ostream &Out, key_type_ref Key, unsigned KeyLen) {
+    Out.write(Key.USR.data(), KeyLen);
+  }
+
+  void EmitData(raw_ostream &Out, key_type_ref Key, data_type_ref Data,
+                unsigned DataLen) {
+    using namespace llvm::support;
+    endian::Writer<little> LE(Out);
+    for (const RecordOccurrence &Occur : Data) {
+      LE.write<uint8_t>(static_cast<uint8_t>(Occur.Kind));
+      LE.write<uint32_t>(Occur.Roles);
+      LE.write<uint32_t>(Occur.Line);
+      LE.write<uint32_t>(Occur.Column);
+    }
+  }
+};
+
+/// \brief Trait used to read the USR -> occurrences table of a record file.
+class RecordReaderTrait {
+public:
+  typedef StringRef external_key_type;
+  typedef StringRef internal_key_type;
+  typedef SmallVector<RecordOccurrence, 4> data_type;
+  typedef unsigned hash_value_type;
+  typedef unsigned offset_type;
+
+  static bool EqualKey(const internal_key_type &a, const internal_key_type &b) {
+    return a == b;
+  }
+
+  static hash_value_type ComputeHash(const internal_key_type &a) {
+    return static_cast<hash_value_type>(hashUSR(a).Low);
+  }
+
+  static std::pair<unsigned, unsigned>
+  ReadKeyDataLength(const unsigned char *&d) {
+    using namespace llvm::support;
+    unsigned KeyLen = endian::readNext<uint32_t, little, unaligned>(d);
+    unsigned DataLen = endian::readNext<uint32_t, little, unaligned>(d);
+    return std::make_pair(KeyLen, DataLen);
+  }
+
+  static const internal_key_type &
+  GetInternalKey(const external_key_type &x) { return x; }
+
+  static const external_key_type &
+  GetExternalKey(const internal_key_type &x) { return x; }
+
+  static internal_key_type ReadKey(const unsigned char *d, unsigned n) {
+    return StringRef((const char *)d, n);
+  }
+
+  static data_type ReadData(const internal_key_type &k, const unsigned char *d,
+                            unsigned DataLen) {
+    using namespace llvm::support;
+    data_type Result;
+    while (DataLen >= RecordOccurrenceSize) {
+      RecordOccurrence Occur;
+      Occur.Kind = static_cast<SymbolKind>(
+          endian::readNext<uint8_t, little, unaligned>(d));
+      Occur.Roles = endian::readNext<uint32_t, little, unaligned>(d);
+      Occur.Line = endian::readNext<uint32_t, little, unaligned>(d);
+      Occur.Column = endian::readNext<uint32_t, little, unaligned>(d);
+      Result.push_back(Occur);
+      DataLen -= RecordOccurrenceSize;
+    }
+    return Result;
+  }
+};
+
+typedef llvm::OnDiskChainedHashTable<RecordReaderTrait> RecordTable;
+
+} // namespace store
+} // namespace index
+} // namespace clang
+
+#endif
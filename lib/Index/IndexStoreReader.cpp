@@ -0,0 +1,245 @@
+//===- IndexStoreReader.cpp - Read index data from the index store --------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Index/IndexStore.h"
+#include "IndexStoreFormat.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/Chrono.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace clang;
+using namespace clang::index;
+using namespace clang::index::store;
+
+namespace {
+
+/// \brief Cursor over the contents of a unit or record file that fails
+/// softly on truncated input.
+class BufferCursor {
+  const unsigned char *Ptr;
+  const unsigned char *End;
+
+public:
+  explicit BufferCursor(StringRef Data)
+      : Ptr((const unsigned char *)Data.begin()),
+        End((const unsigned char *)Data.end()) {}
+
+  bool readMagic(const char (&Magic)[4]) {
+    if (End - Ptr < 4 || memcmp(Ptr, Magic, 4) != 0)
+      return false;
+    Ptr += 4;
+    return true;
+  }
+
+  template <typename T> bool read(T &Result) {
+    using namespace llvm::support;
+    if (End - Ptr < (ptrdiff_t)sizeof(T))
+      return false;
+    Result = endian::readNext<T, little, unaligned>(Ptr);
+    return true;
+  }
+
+  bool readString(StringRef &Result) {
+    uint32_t Len;
+    if (!read(Len) || End - Ptr < (ptrdiff_t)Len)
+      return false;
+    Result = StringRef((const char *)Ptr, Len);
+    Ptr += Len;
+    return true;
+  }
+};
+
+} // anonymous namespace
+
+/// \brief A memory-mapped record file.
+class IndexStoreReader::RecordFile {
+public:
+  std::unique_ptr<llvm::MemoryBuffer> Buffer;
+  std::unique_ptr<RecordTable> Table;
+  StringRef FilePath;
+};
+
+IndexStoreReader::IndexStoreReader(StringRef StorePath)
+  : StorePath(StorePath) {}
+
+IndexStoreReader::~IndexStoreReader() {}
+
+std::unique_ptr<IndexStoreReader>
+IndexStoreReader::open(StringRef StorePath, std::string &Error) {
+  SmallString<256> VersionDir(StorePath);
+  llvm::sys::path::append(VersionDir, getStoreVersionDirName());
+  if (!llvm::sys::fs::is_directory(VersionDir)) {
+    Error = "no index store of version " + getStoreVersionDirName().str() +
+            " found at '" + StorePath.str() + "'";
+    return nullptr;
+  }
+  return std::unique_ptr<IndexStoreReader>(new IndexStoreReader(StorePath));
+}
+
+IndexStoreReader::RecordFile *
+IndexStoreReader::getRecord(StringRef RecordName) {
+  auto Known = Records.find(RecordName);
+  if (Known != Records.end())
+    return Known->second.get();
+
+  std::unique_ptr<RecordFile> &Result = Records[RecordName];
+
+  SmallString<256> RecordPath(StorePath);
+  llvm::sys::path::append(RecordPath, getStoreVersionDirName(),
+                          getRecordsDirName(), RecordName);
+  // Record files are never modified in place, so they can safely be mapped.
+  auto BufferOrErr = llvm::MemoryBuffer::getFile(
+      RecordPath, /*FileSize=*/-1, /*RequiresNullTerminator=*/false,
+      /*IsVolatileSize=*/false);
+  if (!BufferOrErr)
+    return nullptr;
+
+  std::unique_ptr<RecordFile> Record(new RecordFile());
+  Record->Buffer = std::move(*BufferOrErr);
+  StringRef Data = Record->Buffer->getBuffer();
+
+  BufferCursor Cursor(Data);
+  uint32_t Version, BucketOffset;
+  if (!Cursor.readMagic(RecordMagic) || !Cursor.read(Version) ||
+      Version != StoreFormatVersion || !Cursor.read(BucketOffset) ||
+      !Cursor.readString(Record->FilePath) ||
+      BucketOffset < RecordHeaderSize || BucketOffset >= Data.size())
+    return nullptr;
+
+  const unsigned char *Base = (const unsigned char *)Data.data();
+  Record->Table.reset(RecordTable::Create(Base + BucketOffset, Base));
+  Result = std::move(Record);
+  return Result.get();
+}
+
+bool IndexStoreReader::foreachUnit(
+    llvm::function_ref<bool(StringRef UnitName)> Receiver) {
+  SmallString<256> UnitsDir(StorePath);
+  llvm::sys::path::append(UnitsDir, getStoreVersionDirName(),
+                          getUnitsDirName());
+
+  // Collect and sort the names so that clients see a stable order.
+  std::vector<std::string> UnitNames;
+  std::error_code EC;
+  for (llvm::sys::fs::directory_iterator Dir(UnitsDir, EC), DirEnd;
+       Dir != DirEnd && !EC; Dir.increment(EC)) {
+    StringRef Name = llvm::sys::path::filename(Dir->path());
+    // Unit names end in an MD5 hash; skip temporary files left behind by
+    // interrupted writers, which carry an additional random suffix.
+    if (Name.rsplit('-').second.size() != 32)
+      continue;
+    UnitNames.push_back(Name);
+  }
+  std::sort(UnitNames.begin(), UnitNames.end());
+
+  for (const std::string &Name : UnitNames)
+    if (!Receiver(Name))
+      return false;
+  return true;
+}
+
+bool IndexStoreReader::foreachUnitDependency(
+    StringRef UnitName,
+    llvm::function_ref<bool(const StoreUnitDependency &)> Receiver) {
+  SmallString<256> UnitPath(StorePath);
+  llvm::sys::path::append(UnitPath, getStoreVersionDirName(),
+                          getUnitsDirName(), UnitName);
+  auto BufferOrErr = llvm::MemoryBuffer::getFile(UnitPath);
+  if (!BufferOrErr)
+    return false;
+
+  BufferCursor Cursor((*BufferOrErr)->getBuffer());
+  uint32_t Version, NumDeps;
+  StringRef MainPath;
+  if (!Cursor.readMagic(UnitMagic) || !Cursor.read(Version) ||
+      Version != StoreFormatVersion || !Cursor.readString(MainPath) ||
+      !Cursor.read(NumDeps))
+    return false;
+
+  for (unsigned I = 0; I != NumDeps; ++I) {
+    StoreUnitDependency Dep;
+    if (!Cursor.read(Dep.Size) || !Cursor.read(Dep.ModTime) ||
+        !Cursor.readString(Dep.FilePath) || !Cursor.readString(Dep.RecordName))
+      return false;
+    if (!Receiver(Dep))
+      return false;
+  }
+  return true;
+}
+
+bool IndexStoreReader::isUnitUpToDate(StringRef MainFilePath) {
+  SmallString<256> AbsPath;
+  getAbsolutePath(MainFilePath, AbsPath);
+  SmallString<128> UnitName;
+  getUnitName(AbsPath, UnitName);
+
+  bool HasDeps = false;
+  bool UpToDate = foreachUnitDependency(
+      UnitName, [&](const StoreUnitDependency &Dep) -> bool {
+    HasDeps = true;
+    llvm::sys::fs::file_status Status;
+    if (llvm::sys::fs::status(Dep.FilePath, Status) ||
+        Status.getSize() != Dep.Size ||
+        (uint64_t)llvm::sys::toTimeT(Status.getLastModificationTime()) !=
+            Dep.ModTime)
+      return false;
+    if (Dep.RecordName.empty())
+      return true;
+    SmallString<256> RecordPath(StorePath);
+    llvm::sys::path::append(RecordPath, getStoreVersionDirName(),
+                            getRecordsDirName(), Dep.RecordName);
+    return llvm::sys::fs::exists(RecordPath);
+  });
+  return UpToDate && HasDeps;
+}
+
+bool IndexStoreReader::foreachOccurrenceOfUSR(
+    StringRef USR, SymbolRoleSet RoleFilter,
+    llvm::function_ref<bool(const StoreOccurrence &)> Receiver) {
+  // Different units usually share records for common headers; visit each
+  // record only once.
+  llvm::StringSet<> VisitedRecords;
+  bool Continue = true;
+  foreachUnit([&](StringRef UnitName) -> bool {
+    foreachUnitDependency(UnitName, [&](const StoreUnitDependency &Dep) {
+      if (Dep.RecordName.empty() ||
+          !VisitedRecords.insert(Dep.RecordName).second)
+        return true;
+      RecordFile *Record = getRecord(Dep.RecordName);
+      if (!Record)
+        return true;
+
+      auto Pos = Record->Table->find(USR);
+      if (Pos == Record->Table->end())
+        return true;
+
+      for (const RecordOccurrence &Occur : *Pos) {
+        if (RoleFilter && !(Occur.Roles & RoleFilter))
+          continue;
+        StoreOccurrence Result;
+        Result.USR = USR;
+        Result.FilePath = Record->FilePath;
+        Result.Kind = Occur.Kind;
+        Result.Roles = Occur.Roles;
+        Result.Line = Occur.Line;
+        Result.Column = Occur.Column;
+        if (!Receiver(Result))
+          return Continue = false;
+      }
+      return true;
+    });
+    return Continue;
+  });
+  return Continue;
+}
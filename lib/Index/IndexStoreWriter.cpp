@@ -0,0 +1,306 @@
+//===- IndexStoreWriter.cpp - Write index data to the index store ---------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Index/IndexStore.h"
+#include "IndexStoreFormat.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/Basic/FileManager.h"
+#include "clang/Basic/FileUtilities.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/Frontend/FrontendAction.h"
+#include "clang/Index/IndexDataConsumer.h"
+#include "clang/Index/USRGeneration.h"
+#include "clang/Lex/MacroInfo.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/Path.h"
+#include <algorithm>
+
+using namespace clang;
+using namespace clang::index;
+using namespace clang::index::store;
+
+/// \brief Compute the name of the record for \p File. The name changes
+/// whenever the file is modified, so an existing record with the same name
+/// holds up-to-date occurrences.
+static void getRecordName(const FileEntry *File, SmallVectorImpl<char> &Name) {
+  SmallString<256> AbsPath;
+  getAbsolutePath(File->getName(), AbsPath);
+
+  llvm::MD5 Hash;
+  Hash.update(AbsPath);
+  Hash.update(llvm::utostr(File->getSize()));
+  Hash.update(llvm::utostr(File->getModificationTime()));
+  llvm::MD5::MD5Result Result;
+  Hash.final(Result);
+  SmallString<32> HexHash;
+  llvm::MD5::stringifyResult(Result, HexHash);
+
+  Name.clear();
+  llvm::raw_svector_ostream OS(Name);
+  OS << llvm::sys::path::filename(AbsPath) << '-' << HexHash;
+}
+
+static void writeString(llvm::support::endian::Writer<llvm::support::little> &LE,
+                        raw_ostream &OS, StringRef Str) {
+  LE.write<uint32_t>(Str.size());
+  OS << Str;
+}
+
+namespace {
+
+/// \brief The occurrences collected for one source file.
+struct FileRecord {
+  const FileEntry *File;
+  SmallString<64> RecordName;
+  /// Whether the store already has an up-to-date record for this file.
+  bool UpToDate;
+  /// The occurrences of each USR, along with the hash of the USR.
+  struct USROccurrences {
+    USRHash Hash;
+    std::vector<RecordOccurrence> Occurrences;
+  };
+  llvm::StringMap<USROccurrences> Occurrences;
+};
+
+class StoreDataConsumer : public IndexDataConsumer {
+  std::string StorePath;
+  ASTContext *Ctx = nullptr;
+  USRCache USRs;
+
+  llvm::DenseMap<const FileEntry *, std::unique_ptr<FileRecord>> FileRecords;
+  llvm::DenseMap<FileID, FileRecord *> FileIDRecords;
+
+public:
+  explicit StoreDataConsumer(StringRef StorePath) : StorePath(StorePath) {}
+
+  void initialize(ASTContext &Context) override {
+    Ctx = &Context;
+    USRs.clear();
+  }
+
+  bool handleDeclOccurence(const Decl *D, SymbolRoleSet Roles,
+                           ArrayRef<SymbolRelation> Relations,
+                           FileID FID, unsigned Offset,
+                           ASTNodeInfo ASTNode) override {
+    FileRecord *Record = getFileRecord(FID);
+    if (!Record)
+      return true;
+
+    StringRef USR;
+    USRHash Hash;
+    if (USRs.getUSR(D, USR) || USRs.getUSRHash(D, Hash))
+      return true;
+
+    addOccurrence(*Record, USR, Hash, getSymbolInfo(D).Kind, Roles, FID,
+                  Offset);
+    return true;
+  }
+
+  bool handleMacroOccurence(const IdentifierInfo *Name,
+                            const MacroInfo *MI, SymbolRoleSet Roles,
+                            FileID FID, unsigned Offset) override {
+    FileRecord *Record = getFileRecord(FID);
+    if (!Record || !MI)
+      return true;
+
+    SmallString<256> USR;
+    if (generateUSRForMacro(Name->getName(), MI->getDefinitionLoc(),
+                            Ctx->getSourceManager(), USR))
+      return true;
+
+    addOccurrence(*Record, USR, hashUSR(USR), SymbolKind::Macro, Roles, FID,
+                  Offset);
+    return true;
+  }
+
+  void finish() override;
+
+private:
+  /// \returns the record collecting the occurrences of \p FID, or null if
+  /// \p FID is not a file or its record is already up-to-date in the store.
+  FileRecord *getFileRecord(FileID FID);
+
+  void addOccurrence(FileRecord &Record, StringRef USR, USRHash Hash,
+                     SymbolKind Kind, SymbolRoleSet Roles, FileID FID,
+                     unsigned Offset) {
+    SourceManager &SM = Ctx->getSourceManager();
+    RecordOccurrence Occur;
+    Occur.Kind = Kind;
+    Occur.Roles = Roles;
+    Occur.Line = SM.getLineNumber(FID, Offset);
+    Occur.Column = SM.getColumnNumber(FID, Offset);
+    FileRecord::USROccurrences &Entry = Record.Occurrences[USR];
+    Entry.Hash = Hash;
+    Entry.Occurrences.push_back(Occur);
+  }
+
+  bool writeRecord(StringRef RecordsDir, FileRecord &Record);
+  bool writeUnit(StringRef UnitsDir);
+};
+
+} // anonymous namespace
+
+FileRecord *StoreDataConsumer::getFileRecord(FileID FID) {
+  auto Known = FileIDRecords.find(FID);
+  if (Known != FileIDRecords.end())
+    return Known->second;
+
+  FileRecord *&Result = FileIDRecords[FID];
+  const FileEntry *File = Ctx->getSourceManager().getFileEntryForID(FID);
+  if (!File)
+    return Result = nullptr;
+
+  std::unique_ptr<FileRecord> &Record = FileRecords[File];
+  if (!Record) {
+    Record.reset(new FileRecord());
+    Record->File = File;
+    getRecordName(File, Record->RecordName);
+
+    SmallString<256> RecordPath(StorePath);
+    llvm::sys::path::append(RecordPath, getStoreVersionDirName(),
+                            getRecordsDirName(), Record->RecordName);
+    Record->UpToDate = llvm::sys::fs::exists(RecordPath);
+  }
+
+  return Result = Record->UpToDate ? nullptr : Record.get();
+}
+
+bool StoreDataConsumer::writeRecord(StringRef RecordsDir, FileRecord &Record) {
+  using namespace llvm::support;
+
+  llvm::OnDiskChainedHashTableGenerator<RecordWriterTrait> Generator;
+  RecordWriterTrait Trait;
+  for (auto &Entry : Record.Occurrences) {
+    // A header included more than once, e.g. one without an include guard,
+    // is indexed once per FileID but has a single record.
+    std::vector<RecordOccurrence> &Occurs = Entry.getValue().Occurrences;
+    std::sort(Occurs.begin(), Occurs.end());
+    Occurs.erase(std::unique(Occurs.begin(), Occurs.end()), Occurs.end());
+    RecordKey Key = {Entry.getKey(), Entry.getValue().Hash};
+    Generator.insert(Key, Occurs, Trait);
+  }
+
+  SmallString<256> AbsPath;
+  getAbsolutePath(Record.File->getName(), AbsPath);
+
+  SmallString<4096> Buffer;
+  {
+    llvm::raw_svector_ostream Out(Buffer);
+    endian::Writer<little> LE(Out);
+    Out.write(RecordMagic, sizeof(RecordMagic));
+    LE.write<uint32_t>(StoreFormatVersion);
+    // Placeholder for the table offset, patched below.
+    LE.write<uint32_t>(0);
+    writeString(LE, Out, AbsPath);
+    uint32_t BucketOffset = Generator.Emit(Out, Trait);
+    endian::write32le(&Buffer[8], BucketOffset);
+  }
+
+  SmallString<256> RecordPath(RecordsDir);
+  llvm::sys::path::append(RecordPath, Record.RecordName);
+  return writeFileAtomically(RecordPath, Buffer);
+}
+
+bool StoreDataConsumer::writeUnit(StringRef UnitsDir) {
+  using namespace llvm::support;
+
+  SourceManager &SM = Ctx->getSourceManager();
+  const FileEntry *MainFile = SM.getFileEntryForID(SM.getMainFileID());
+  if (!MainFile)
+    return true;
+
+  struct Dependency {
+    std::string Path;
+    StringRef RecordName;
+    uint64_t Size;
+    uint64_t ModTime;
+  };
+  std::vector<Dependency> Deps;
+  for (auto I = SM.fileinfo_begin(), E = SM.fileinfo_end(); I != E; ++I) {
+    const FileEntry *File = I->first;
+    SmallString<256> AbsPath;
+    getAbsolutePath(File->getName(), AbsPath);
+
+    Dependency Dep;
+    Dep.Path = AbsPath.str();
+    auto Record = FileRecords.find(File);
+    if (Record != FileRecords.end() &&
+        (Record->second->UpToDate || !Record->second->Occurrences.empty()))
+      Dep.RecordName = Record->second->RecordName;
+    Dep.Size = File->getSize();
+    Dep.ModTime = File->getModificationTime();
+    Deps.push_back(std::move(Dep));
+  }
+  // Sort dependencies so the unit file does not depend on the hashing of
+  // FileEntry pointers.
+  std::sort(Deps.begin(), Deps.end(),
+            [](const Dependency &LHS, const Dependency &RHS) {
+    return LHS.Path < RHS.Path;
+  });
+
+  SmallString<256> MainPath;
+  getAbsolutePath(MainFile->getName(), MainPath);
+
+  SmallString<1024> Buffer;
+  {
+    llvm::raw_svector_ostream Out(Buffer);
+    endian::Writer<little> LE(Out);
+    Out.write(UnitMagic, sizeof(UnitMagic));
+    LE.write<uint32_t>(StoreFormatVersion);
+    writeString(LE, Out, MainPath);
+    LE.write<uint32_t>(Deps.size());
+    for (const Dependency &Dep : Deps) {
+      LE.write<uint64_t>(Dep.Size);
+      LE.write<uint64_t>(Dep.ModTime);
+      writeString(LE, Out, Dep.Path);
+      writeString(LE, Out, Dep.RecordName);
+    }
+  }
+
+  SmallString<128> UnitName;
+  getUnitName(MainPath, UnitName);
+  SmallString<256> UnitPath(UnitsDir);
+  llvm::sys::path::append(UnitPath, UnitName);
+  return writeFileAtomically(UnitPath, Buffer);
+}
+
+void StoreDataConsumer::finish() {
+  if (!Ctx)
+    return;
+
+  SmallString<256> VersionDir(StorePath);
+  llvm::sys::path::append(VersionDir, getStoreVersionDirName());
+  SmallString<256> RecordsDir(VersionDir);
+  llvm::sys::path::append(RecordsDir, getRecordsDirName());
+  SmallString<256> UnitsDir(VersionDir);
+  llvm::sys::path::append(UnitsDir, getUnitsDirName());
+  if (llvm::sys::fs::create_directories(RecordsDir) ||
+      llvm::sys::fs::create_directories(UnitsDir))
+    return;
+
+  for (const auto &Entry : FileRecords) {
+    FileRecord &Record = *Entry.second;
+    if (Record.UpToDate || Record.Occurrences.empty())
+      continue;
+    writeRecord(RecordsDir, Record);
+  }
+
+  writeUnit(UnitsDir);
+}
+
+std::unique_ptr<FrontendAction>
+index::createIndexStoreAction(StringRef StorePath, IndexingOptions Opts,
+                              std::unique_ptr<FrontendAction> WrappedAction) {
+  auto DataConsumer = std::make_shared<StoreDataConsumer>(StorePath);
+  return createIndexingAction(std::move(DataConsumer), Opts,
+                              std::move(WrappedAction));
+}
@@ -12,6 +12,7 @@
 #include "clang/AST/DeclTemplate.h"
 #include "clang/AST/DeclVisitor.h"
 #include "clang/Lex/PreprocessingRecord.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -57,8 +58,7 @@ static StringRef GetExternalSourceContainer(const NamedDecl *D) {
 
 namespace {
 class USRGenerator : public ConstDeclVisitor<USRGenerator> {
-  SmallVectorImpl<char> &Buf;
-  llvm::raw_svector_ostream Out;
+  raw_ostream &Out;
   bool IgnoreResults;
   ASTContext *Context;
   bool generatedLoc;
@@ -66,9 +66,8 @@ class USRGenerator : public ConstDeclVisitor<USRGenerator> {
   llvm::DenseMap<const Type *, unsigned> TypeSubstitutions;
   
 public:
-  explicit USRGenerator(ASTContext *Ctx, SmallVectorImpl<char> &Buf)
-  : Buf(Buf),
-    Out(Buf),
+  explicit USRGenerator(ASTContext *Ctx, raw_ostream &Out)
+  : Out(Out),
     IgnoreResults(false),
     Context(Ctx),
     generatedLoc(false)
@@ -177,9 +176,9 @@ public:
 //===----------------------------------------------------------------------===//
 
 bool USRGenerator::EmitDeclName(const NamedDecl *D) {
-  const unsigned startSize = Buf.size();
+  const uint64_t startSize = Out.tell();
   D->printName(Out);
-  const unsigned endSize = Buf.size();
+  const uint64_t endSize = Out.tell();
   return startSize == endSize;
 }
 
@@ -219,9 +218,9 @@ void USRGenerator::VisitFunctionDecl(const FunctionDecl *D) {
   if (ShouldGenerateLocation(D) && GenLoc(D, /*IncludeOffset=*/isLocal(D)))
     return;
 
-  const unsigned StartSize = Buf.size();
+  const uint64_t StartSize = Out.tell();
   VisitDeclContext(D->getDeclContext());
-  if (Buf.size() == StartSize)
+  if (Out.tell() == StartSize)
     GenExtSymbolContainer(D);
 
   bool IsTemplate = false;
@@ -531,30 +530,27 @@ void USRGenerator::VisitTagDecl(const TagDecl *D) {
     }
   }
   
-  Out << '@';
-  assert(Buf.size() > 0);
-  const unsigned off = Buf.size() - 1;
-
-  if (EmitDeclName(D)) {
-    if (const TypedefNameDecl *TD = D->getTypedefNameForAnonDecl()) {
-      Buf[off] = 'A';
-      Out << '@' << *TD;
-    }
-  else {
-    if (D->isEmbeddedInDeclarator() && !D->isFreeStanding()) {
-      printLoc(Out, D->getLocation(), Context->getSourceManager(), true);
-    } else {
-      Buf[off] = 'a';
-      if (auto *ED = dyn_cast<EnumDecl>(D)) {
-        // Distinguish USRs of anonymous enums by using their first enumerator.
-        auto enum_range = ED->enumerators();
-        if (enum_range.begin() != enum_range.end()) {
-          Out << '@' << **enum_range.begin();
-        }
+  // Anonymous tags replace the '@' separator with a marker, so decide on it
+  // before anything is written; the output stream may not be rewindable.
+  if (!D->getDeclName().isEmpty()) {
+    Out << '@';
+    EmitDeclName(D);
+  } else if (const TypedefNameDecl *TD = D->getTypedefNameForAnonDecl()) {
+    Out << 'A';
+    Out << '@' << *TD;
+  } else if (D->isEmbeddedInDeclarator() && !D->isFreeStanding()) {
+    Out << '@';
+    printLoc(Out, D->getLocation(), Context->getSourceManager(), true);
+  } else {
+    Out << 'a';
+    if (auto *ED = dyn_cast<EnumDecl>(D)) {
+      // Distinguish USRs of anonymous enums by using their first enumerator.
+      auto enum_range = ED->enumerators();
+      if (enum_range.begin() != enum_range.end()) {
+        Out << '@' << **enum_range.begin();
       }
     }
   }
-  }
   
   // For a class template specialization, mangle the template arguments.
   if (const ClassTemplateSpecializationDecl *Spec
@@ -983,17 +979,118 @@ void clang::index::generateUSRForEnumConstant(StringRef EnumConstantName,
 
 bool clang::index::generateUSRForDecl(const Decl *D,
                                       SmallVectorImpl<char> &Buf) {
+  llvm::raw_svector_ostream Out(Buf);
+  return generateUSRForDecl(D, Out);
+}
+
+bool clang::index::generateUSRForDecl(const Decl *D, raw_ostream &OS) {
   if (!D)
     return true;
   // We don't ignore decls with invalid source locations. Implicit decls, like
   // C++'s operator new function, can have invalid locations but it is fine to
   // create USRs that can identify them.
 
-  USRGenerator UG(&D->getASTContext(), Buf);
+  USRGenerator UG(&D->getASTContext(), OS);
   UG.Visit(D);
   return UG.ignoreResults();
 }
 
+namespace {
+/// \brief A stream that feeds everything written to it into an MD5 hash
+/// instead of materializing the string.
+class USRHashStream : public raw_ostream {
+  llvm::MD5 Hash;
+  uint64_t Pos = 0;
+  char Buffer[256];
+
+  void write_impl(const char *Ptr, size_t Size) override {
+    Hash.update(ArrayRef<uint8_t>((const uint8_t *)Ptr, Size));
+    Pos += Size;
+  }
+
+  uint64_t current_pos() const override { return Pos; }
+
+public:
+  USRHashStream() {
+    // Use an inline buffer so hashing does not allocate.
+    SetBuffer(Buffer, sizeof(Buffer));
+  }
+
+  ~USRHashStream() override { flush(); }
+
+  USRHash getHash() {
+    flush();
+    llvm::MD5::MD5Result Result;
+    Hash.final(Result);
+    USRHash H;
+    H.Low = Result.low();
+    H.High = Result.high();
+    return H;
+  }
+};
+} // end anonymous namespace
+
+USRHash clang::index::hashUSR(StringRef USR) {
+  USRHashStream OS;
+  OS << USR;
+  return OS.getHash();
+}
+
+bool clang::index::generateUSRHashForDecl(const Decl *D, USRHash &Hash) {
+  USRHashStream OS;
+  if (generateUSRForDecl(D, OS))
+    return true;
+  Hash = OS.getHash();
+  return false;
+}
+
+bool USRCache::getUSR(const Decl *D, StringRef &USR) {
+  auto Known = USRs.find(D);
+  if (Known != USRs.end()) {
+    USR = Known->second;
+    return USR.empty();
+  }
+
+  SmallString<256> Buf;
+  if (generateUSRForDecl(D, Buf)) {
+    USRs[D] = StringRef();
+    return true;
+  }
+
+  // Redeclarations usually share a USR; intern it so they share storage.
+  USR = Strings.insert(Buf).first->getKey();
+  USRs[D] = USR;
+  return false;
+}
+
+bool USRCache::getUSRHash(const Decl *D, USRHash &Hash) {
+  auto KnownHash = Hashes.find(D);
+  if (KnownHash != Hashes.end()) {
+    Hash = KnownHash->second;
+    return false;
+  }
+
+  auto Known = USRs.find(D);
+  if (Known != USRs.end()) {
+    if (Known->second.empty())
+      return true;
+    Hash = hashUSR(Known->second);
+  } else if (generateUSRHashForDecl(D, Hash)) {
+    USRs[D] = StringRef();
+    return true;
+  }
+
+  Hashes[D] = Hash;
+  return false;
+}
+
+void USRCache::clear() {
+  USRs.clear();
+  Hashes.clear();
+  Strings.clear();
+  Strings.getAllocator().Reset();
+}
+
 bool clang::index::generateUSRForMacro(const MacroDefinitionRecord *MD,
                                        const SourceManager &SM,
                                        SmallVectorImpl<char> &Buf) {
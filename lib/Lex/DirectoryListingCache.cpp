@@ -0,0 +1,392 @@
+//===--- DirectoryListingCache.cpp - Cached header directory listings -----===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the DirectoryListingCache class.
+//
+// Cache files have the following layout, all integers little-endian:
+//
+//   'C' 'D' 'L' 'C'  uint32 version  uint32 table-offset
+//   on-disk chained hash table mapping directory path -> listing
+//
+// where each listing is stored as
+//
+//   uint64 mtime-in-nanoseconds  uint64 read-time-in-nanoseconds
+//   { uint16 name-length  name } *
+//
+// with the lowercased names in sorted order. The read time is when the
+// directory was listed, so that a later compilation can tell whether the
+// listing may have missed a change that left the modification time as is.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/DirectoryListingCache.h"
+#include "clang/Basic/CharInfo.h"
+#include "clang/Basic/FileUtilities.h"
+#include "clang/Basic/VirtualFileSystem.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/OnDiskHashTable.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/StringSaver.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace clang;
+
+static const char CacheFileMagic[4] = { 'C', 'D', 'L', 'C' };
+
+/// \brief The version of the cache file format. Files of any other version
+/// are ignored and overwritten.
+static const unsigned CacheFileVersion = 2;
+
+/// \brief Size of the fixed cache file header: magic, version and the offset
+/// of the hash table buckets.
+static const unsigned CacheFileHeaderSize = 12;
+
+static void lowercaseName(StringRef Name, SmallVectorImpl<char> &Result) {
+  Result.clear();
+  for (char C : Name)
+    Result.push_back(toLowercase(C));
+}
+
+/// \brief Whether a directory modified at \p ModTime may still change without
+/// its modification time changing after it was listed at \p ReadTime.
+///
+/// File systems may record modification times at a granularity as coarse as
+/// a second, so an entry added in the same second as the directory was read
+/// may leave its modification time unchanged. Such listings must not be
+/// reused.
+static bool isRacyListing(llvm::sys::TimePoint<> ModTime,
+                          llvm::sys::TimePoint<> ReadTime) {
+  return ModTime >=
+         std::chrono::time_point_cast<std::chrono::seconds>(ReadTime);
+}
+
+static uint64_t getNanoseconds(llvm::sys::TimePoint<> Time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             Time.time_since_epoch()).count();
+}
+
+static llvm::sys::TimePoint<> getTimePoint(uint64_t Nanoseconds) {
+  return llvm::sys::TimePoint<>(std::chrono::nanoseconds(Nanoseconds));
+}
+
+namespace {
+
+/// \brief Trait used to emit the directory -> listing table of a cache file.
+class CacheFileWriterTrait {
+public:
+  typedef StringRef key_type;
+  typedef StringRef key_type_ref;
+  typedef const DirectoryListingCache::Listing *data_type;
+  typedef data_type data_type_ref;
+  typedef unsigned hash_value_type;
+  typedef unsigned offset_type;
+
+  /// The encoded times and the names of each listing.
+  struct ListingData {
+    uint64_t ModTime;
+    uint64_t ReadTime;
+    ArrayRef<StringRef> Names;
+  };
+  llvm::DenseMap<data_type, ListingData> Data;
+
+  static hash_value_type ComputeHash(key_type_ref Key) {
+    return llvm::HashString(Key);
+  }
+
+  std::pair<unsigned, unsigned>
+  EmitKeyDataLength(raw_ostream &Out, key_type_ref Key, data_type_ref D) {
+    using namespace llvm::support;
+    endian::Writer<little> LE(Out);
+    unsigned KeyLen = Key.size();
+    unsigned DataLen = 16;
+    for (StringRef Name : Data[D].Names)
+      DataLen += 2 + Name.size();
+    LE.write<uint32_t>(KeyLen);
+    LE.write<uint32_t>(DataLen);
+    return std::make_pair(KeyLen, DataLen);
+  }
+
+  void EmitKey(raw_ostream &Out, key_type_ref Key, unsigned KeyLen) {
+    Out.write(Key.data(), KeyLen);
+  }
+
+  void EmitData(raw_ostream &Out, key_type_ref Key, data_type_ref D,
+                unsigned DataLen) {
+    using namespace llvm::support;
+    endian::Writer<little> LE(Out);
+    const ListingData &Listing = Data[D];
+    LE.write<uint64_t>(Listing.ModTime);
+    LE.write<uint64_t>(Listing.ReadTime);
+    for (StringRef Name : Listing.Names) {
+      LE.write<uint16_t>(Name.size());
+      Out << Name;
+    }
+  }
+};
+
+/// \brief Trait used to read the directory -> listing table of a cache file.
+class CacheFileReaderTrait {
+public:
+  typedef StringRef external_key_type;
+  typedef StringRef internal_key_type;
+  typedef unsigned hash_value_type;
+  typedef unsigned offset_type;
+
+  /// \brief A listing that has not been decoded yet.
+  struct data_type {
+    uint64_t ModTime;
+    uint64_t ReadTime;
+    const unsigned char *Names;
+    unsigned NamesLen;
+  };
+
+  static bool EqualKey(const internal_key_type &a, const internal_key_type &b) {
+    return a == b;
+  }
+
+  static hash_value_type ComputeHash(const internal_key_type &a) {
+    return llvm::HashString(a);
+  }
+
+  static std::pair<unsigned, unsigned>
+  ReadKeyDataLength(const unsigned char *&d) {
+    using namespace llvm::support;
+    unsigned KeyLen = endian::readNext<uint32_t, little, unaligned>(d);
+    unsigned DataLen = endian::readNext<uint32_t, little, unaligned>(d);
+    return std::make_pair(KeyLen, DataLen);
+  }
+
+  static const internal_key_type &
+  GetInternalKey(const external_key_type &x) { return x; }
+
+  static const external_key_type &
+  GetExternalKey(const internal_key_type &x) { return x; }
+
+  static internal_key_type ReadKey(const unsigned char *d, unsigned n) {
+    return StringRef((const char *)d, n);
+  }
+
+  static data_type ReadData(const internal_key_type &k, const unsigned char *d,
+                            unsigned DataLen) {
+    using namespace llvm::support;
+    data_type Result;
+    Result.ModTime = endian::readNext<uint64_t, little, unaligned>(d);
+    Result.ReadTime = endian::readNext<uint64_t, little, unaligned>(d);
+    Result.Names = d;
+    Result.NamesLen = DataLen - 16;
+    return Result;
+  }
+};
+
+} // end anonymous namespace
+
+class DirectoryListingCache::CacheFileTable {
+public:
+  typedef llvm::OnDiskIterableChainedHashTable<CacheFileReaderTrait> Table;
+  std::unique_ptr<Table> Listings;
+};
+
+bool DirectoryListingCache::Listing::contains(StringRef Name) const {
+  SmallString<64> Lower;
+  lowercaseName(Name, Lower);
+  return std::binary_search(Names.begin(), Names.end(), StringRef(Lower));
+}
+
+DirectoryListingCache::DirectoryListingCache() {}
+
+DirectoryListingCache::~DirectoryListingCache() {}
+
+std::shared_ptr<const DirectoryListingCache::Listing>
+DirectoryListingCache::getLoadedListing(StringRef DirPath) {
+  if (!LoadedTable)
+    return nullptr;
+
+  CacheFileTable::Table &Table = *LoadedTable->Listings;
+  auto Pos = Table.find(DirPath);
+  if (Pos == Table.end())
+    return nullptr;
+
+  using namespace llvm::support;
+  CacheFileReaderTrait::data_type Data = *Pos;
+  auto Result = std::make_shared<Listing>();
+  Result->ModTime = getTimePoint(Data.ModTime);
+  Result->ReadTime = getTimePoint(Data.ReadTime);
+  // Never trust a listing that may have missed a change, whoever wrote it.
+  if (isRacyListing(Result->ModTime, Result->ReadTime))
+    return nullptr;
+  Result->CacheFile = LoadedBuffer;
+  const unsigned char *Ptr = Data.Names;
+  const unsigned char *End = Data.Names + Data.NamesLen;
+  while (End - Ptr >= 2) {
+    unsigned Len = endian::readNext<uint16_t, little, unaligned>(Ptr);
+    if (End - Ptr < (ptrdiff_t)Len)
+      return nullptr;
+    Result->Names.push_back(StringRef((const char *)Ptr, Len));
+    Ptr += Len;
+  }
+  // A truncated or unsorted listing could wrongly reject lookups.
+  if (Ptr != End || !std::is_sorted(Result->Names.begin(),
+                                    Result->Names.end()))
+    return nullptr;
+  return Result;
+}
+
+std::shared_ptr<const DirectoryListingCache::Listing>
+DirectoryListingCache::getListing(vfs::FileSystem &FS, StringRef DirPath) {
+  llvm::ErrorOr<vfs::Status> DirStatus = FS.status(DirPath);
+  if (!DirStatus || !DirStatus->isDirectory())
+    return nullptr;
+
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto Known = Listings.find(DirPath);
+    if (Known != Listings.end()) {
+      if (Known->second->ModTime == DirStatus->getLastModificationTime())
+        return Known->second;
+    } else if (auto Loaded = getLoadedListing(DirPath)) {
+      if (Loaded->ModTime == DirStatus->getLastModificationTime()) {
+        Listings[DirPath] = Loaded;
+        return Loaded;
+      }
+    }
+  }
+
+  // Read the directory without holding the lock; concurrent readers of the
+  // same directory produce equivalent listings.
+  llvm::sys::TimePoint<> ReadTime = std::chrono::system_clock::now();
+  auto Result = std::make_shared<Listing>();
+  Result->ModTime = DirStatus->getLastModificationTime();
+  Result->ReadTime = ReadTime;
+  llvm::StringSaver Saver(Result->NameStorage);
+  std::error_code EC;
+  SmallString<64> Lower;
+  for (vfs::directory_iterator Dir = FS.dir_begin(DirPath, EC), DirEnd;
+       Dir != DirEnd; Dir.increment(EC)) {
+    if (EC)
+      break;
+    lowercaseName(llvm::sys::path::filename(Dir->getName()), Lower);
+    Result->Names.push_back(Saver.save(Lower));
+  }
+  // A partial listing could wrongly reject lookups.
+  if (EC)
+    return nullptr;
+  std::sort(Result->Names.begin(), Result->Names.end());
+  Result->Names.erase(std::unique(Result->Names.begin(), Result->Names.end()),
+                      Result->Names.end());
+
+  // A listing of a recently modified directory is only good for the caller.
+  if (isRacyListing(Result->ModTime, Result->ReadTime))
+    return Result;
+
+  std::lock_guard<std::mutex> Lock(Mutex);
+  Listings[DirPath] = Result;
+  Dirty = true;
+  return Result;
+}
+
+bool DirectoryListingCache::loadFromFile(StringRef Path) {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  if (LoadedPath == Path)
+    return LoadedTable == nullptr;
+  LoadedPath = Path;
+  LoadedTable.reset();
+  LoadedBuffer.reset();
+
+  // The file is only ever replaced by renaming, never modified in place, so
+  // it can safely be mapped.
+  auto BufferOrErr = llvm::MemoryBuffer::getFile(
+      Path, /*FileSize=*/-1, /*RequiresNullTerminator=*/false,
+      /*IsVolatileSize=*/false);
+  if (!BufferOrErr)
+    return true;
+
+  using namespace llvm::support;
+  StringRef Data = (*BufferOrErr)->getBuffer();
+  if (Data.size() < CacheFileHeaderSize ||
+      memcmp(Data.data(), CacheFileMagic, sizeof(CacheFileMagic)) != 0)
+    return true;
+  const unsigned char *Base = (const unsigned char *)Data.data();
+  const unsigned char *Ptr = Base + sizeof(CacheFileMagic);
+  uint32_t Version = endian::readNext<uint32_t, little, unaligned>(Ptr);
+  uint32_t BucketOffset = endian::readNext<uint32_t, little, unaligned>(Ptr);
+  if (Version != CacheFileVersion || BucketOffset < CacheFileHeaderSize ||
+      BucketOffset >= Data.size() || (BucketOffset & 0x3))
+    return true;
+
+  LoadedBuffer = std::move(*BufferOrErr);
+  LoadedTable.reset(new CacheFileTable());
+  LoadedTable->Listings.reset(CacheFileTable::Table::Create(
+      Base + BucketOffset, Base + CacheFileHeaderSize, Base));
+  return false;
+}
+
+bool DirectoryListingCache::writeToFile(StringRef Path) {
+  using namespace llvm::support;
+
+  std::lock_guard<std::mutex> Lock(Mutex);
+  if (!Dirty && LoadedPath == Path)
+    return false;
+
+  llvm::OnDiskChainedHashTableGenerator<CacheFileWriterTrait> Generator;
+  CacheFileWriterTrait Trait;
+  auto AddListing = [&](StringRef DirPath, const Listing *L) {
+    Trait.Data[L] = {getNanoseconds(L->ModTime), getNanoseconds(L->ReadTime),
+                     llvm::makeArrayRef(L->Names)};
+    Generator.insert(DirPath, L, Trait);
+  };
+  for (const auto &Entry : Listings)
+    AddListing(Entry.getKey(), Entry.getValue().get());
+
+  // Keep the loaded listings of directories this process did not look at;
+  // other compilations sharing the file may need them.
+  std::vector<std::shared_ptr<const Listing>> KeptListings;
+  if (LoadedTable) {
+    CacheFileTable::Table &Table = *LoadedTable->Listings;
+    for (auto Key = Table.key_begin(), KeyEnd = Table.key_end(); Key != KeyEnd;
+         ++Key) {
+      if (Listings.count(*Key))
+        continue;
+      std::shared_ptr<const Listing> L = getLoadedListing(*Key);
+      if (!L)
+        continue;
+      AddListing(*Key, L.get());
+      KeptListings.push_back(std::move(L));
+    }
+  }
+
+  SmallString<4096> Buffer;
+  {
+    llvm::raw_svector_ostream Out(Buffer);
+    endian::Writer<little> LE(Out);
+    Out.write(CacheFileMagic, sizeof(CacheFileMagic));
+    LE.write<uint32_t>(CacheFileVersion);
+    // Placeholder for the table offset, patched below.
+    LE.write<uint32_t>(0);
+    uint32_t BucketOffset = Generator.Emit(Out, Trait);
+    endian::write32le(&Buffer[8], BucketOffset);
+  }
+
+  if (writeFileAtomically(Path, Buffer))
+    return true;
+  Dirty = false;
+  return false;
+}
+
+IntrusiveRefCntPtr<DirectoryListingCache>
+DirectoryListingCache::getProcessCache() {
+  static IntrusiveRefCntPtr<DirectoryListingCache> ProcessCache(
+      new DirectoryListingCache());
+  return ProcessCache;
+}
@@ -14,6 +14,7 @@
 #include "clang/Lex/HeaderSearch.h"
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/IdentifierTable.h"
+#include "clang/Basic/VirtualFileSystem.h"
 #include "clang/Lex/ExternalPreprocessorSource.h"
 #include "clang/Lex/HeaderMap.h"
 #include "clang/Lex/HeaderSearchOptions.h"
@@ -70,6 +71,7 @@ HeaderSearch::HeaderSearch(std::shared_ptr<HeaderSearchOptions> HSOpts,
   NumIncluded = 0;
   NumMultiIncludeFileOptzn = 0;
   NumFrameworkLookups = NumSubFrameworkLookups = 0;
+  NumDirectoryListingRejections = 0;
 }
 
 HeaderSearch::~HeaderSearch() {
@@ -98,6 +100,9 @@ void HeaderSearch::PrintStats() {
 
   fprintf(stderr, "%d framework lookups.\n", NumFrameworkLookups);
   fprintf(stderr, "%d subframework lookups.\n", NumSubFrameworkLookups);
+  if (ListingCache)
+    fprintf(stderr, "%d lookups rejected by directory listings.\n",
+            NumDirectoryListingRejections);
 }
 
 /// CreateHeaderMap - This method returns a HeaderMap for the specified
@@ -348,6 +353,10 @@ const FileEntry *DirectoryLookup::LookupFile(
       RelativePath->append(Filename.begin(), Filename.end());
     }
 
+    // Avoid a failing stat if the directory cannot contain the file.
+    if (!HS.mayDirectoryContain(getDir()->getName(), Filename, TmpDir))
+      return nullptr;
+
     return HS.getFileAndSuggestModule(TmpDir, IncludeLoc, getDir(),
                                       isSystemHeaderDirectory(),
                                       RequestingModule, SuggestedModule);
@@ -395,6 +404,49 @@ const FileEntry *DirectoryLookup::LookupFile(
   return Result;
 }
 
+void HeaderSearch::setDirectoryListingCache(
+    IntrusiveRefCntPtr<DirectoryListingCache> Cache) {
+  DirectoryListings.clear();
+  if (FileMgr.getVirtualFileSystem() != vfs::getRealFileSystem()) {
+    ListingCache = nullptr;
+    return;
+  }
+  ListingCache = std::move(Cache);
+}
+
+bool HeaderSearch::mayDirectoryContain(StringRef DirPath, StringRef Filename,
+                                       StringRef Path) {
+  if (!ListingCache || Filename.empty())
+    return true;
+
+  // Only the first component of the filename is checked; the listing does
+  // not cover subdirectories.
+  StringRef FirstComponent = *llvm::sys::path::begin(Filename);
+  if (FirstComponent == "." || FirstComponent == "..")
+    return true;
+
+  auto Known = DirectoryListings.find(DirPath);
+  if (Known == DirectoryListings.end()) {
+    // The cache is shared with other compilations, whose working directory
+    // may differ.
+    SmallString<128> AbsDirPath(DirPath);
+    FileMgr.makeAbsolutePath(AbsDirPath);
+    auto Listing = ListingCache->getListing(*FileMgr.getVirtualFileSystem(),
+                                            AbsDirPath);
+    Known = DirectoryListings.insert(std::make_pair(DirPath, Listing)).first;
+  }
+  if (!Known->second || Known->second->contains(FirstComponent))
+    return true;
+
+  // Virtual files, e.g. remapped files, and their directories do not show up
+  // in any listing.
+  if (FileMgr.isKnownFile(Path) || FileMgr.isKnownDirectory(Path))
+    return true;
+
+  ++NumDirectoryListingRejections;
+  return false;
+}
+
 /// \brief Given a framework directory, find the top-most framework directory.
 ///
 /// \param FileMgr The file manager to use for directory lookups.
@@ -492,7 +544,13 @@ const FileEntry *DirectoryLookup::DoFrameworkLookup(
   if (!CacheEntry.Directory) {
     HS.IncrementFrameworkLookupCount();
 
-    // If the framework dir doesn't exist, we fail.
+    // If the framework dir doesn't exist, we fail. Check the listing of the
+    // framework directory first to avoid a failing stat.
+    StringRef FrameworkDirName = StringRef(FrameworkName).drop_back();
+    if (!HS.mayDirectoryContain(getFrameworkDir()->getName(),
+                                llvm::sys::path::filename(FrameworkDirName),
+                                FrameworkDirName))
+      return nullptr;
     const DirectoryEntry *Dir = FileMgr.getDirectory(FrameworkName);
     if (!Dir) return nullptr;
 
@@ -505,7 +563,9 @@ const FileEntry *DirectoryLookup::DoFrameworkLookup(
     if (getDirCharacteristic() == SrcMgr::C_User) {
       SmallString<1024> SystemFrameworkMarker(FrameworkName);
       SystemFrameworkMarker += ".system_framework";
-      if (llvm::sys::fs::exists(SystemFrameworkMarker)) {
+      if (HS.mayDirectoryContain(FrameworkDirName, ".system_framework",
+                                 SystemFrameworkMarker) &&
+          llvm::sys::fs::exists(SystemFrameworkMarker)) {
         CacheEntry.IsUserSpecifiedSystemFramework = true;
       }
     }
@@ -530,9 +590,14 @@ const FileEntry *DirectoryLookup::DoFrameworkLookup(
     SearchPath->append(FrameworkName.begin(), FrameworkName.end()-1);
   }
 
-  FrameworkName.append(Filename.begin()+SlashPos+1, Filename.end());
-  const FileEntry *FE = FileMgr.getFile(FrameworkName,
-                                        /*openFile=*/!SuggestedModule);
+  StringRef HeaderName(Filename.begin()+SlashPos+1,
+                       Filename.size()-SlashPos-1);
+  unsigned HeadersDirSize = FrameworkName.size() - 1;
+  FrameworkName += HeaderName;
+  const FileEntry *FE = nullptr;
+  if (HS.mayDirectoryContain(FrameworkName.str().take_front(HeadersDirSize),
+                             HeaderName, FrameworkName))
+    FE = FileMgr.getFile(FrameworkName, /*openFile=*/!SuggestedModule);
   if (!FE) {
     // Check "/System/Library/Frameworks/Cocoa.framework/PrivateHeaders/file.h"
     const char *Private = "Private";
@@ -542,7 +607,10 @@ const FileEntry *DirectoryLookup::DoFrameworkLookup(
       SearchPath->insert(SearchPath->begin()+OrigSize, Private,
                          Private+strlen(Private));
 
-    FE = FileMgr.getFile(FrameworkName, /*openFile=*/!SuggestedModule);
+    HeadersDirSize += strlen(Private);
+    if (HS.mayDirectoryContain(FrameworkName.str().take_front(HeadersDirSize),
+                               HeaderName, FrameworkName))
+      FE = FileMgr.getFile(FrameworkName, /*openFile=*/!SuggestedModule);
   }
 
   // If we found the header and are allowed to suggest a module, do so now.
@@ -1511,9 +1511,24 @@ bool Lexer::tryConsumeIdentifierUTF8Char(const char *&CurPtr) {
 bool Lexer::LexIdentifier(Token &Result, const char *CurPtr) {
   // Match [_A-Za-z0-9]*, we have already matched [_A-Za-z$]
   unsigned Size;
+
+  // Unless the identifier is returned raw, hash it as we scan it, so that
+  // looking it up does not need to hash it again. This requires its first
+  // character to be spelled as a single byte.
+  bool HasHash = !LexingRawMode && CurPtr == BufferPtr + 1;
+  unsigned Hash = 0;
+
   unsigned char C = *CurPtr++;
-  while (isIdentifierBody(C))
-    C = *CurPtr++;
+  if (HasHash) {
+    Hash = IdentifierTable::extendHash(0, *BufferPtr);
+    while (isIdentifierBody(C)) {
+      Hash = IdentifierTable::extendHash(Hash, C);
+      C = *CurPtr++;
+    }
+  } else {
+    while (isIdentifierBody(C))
+      C = *CurPtr++;
+  }
 
   --CurPtr;   // Back up over the skipped character.
 
@@ -1536,7 +1551,8 @@ FinishIdentifier:
 
     // Fill in Result.IdentifierInfo and update the token kind,
     // looking up the identifier in the identifier table.
-    IdentifierInfo *II = PP->LookUpIdentifierInfo(Result);
+    IdentifierInfo *II = HasHash ? PP->LookUpIdentifierInfo(Result, Hash)
+                                 : PP->LookUpIdentifierInfo(Result);
 
     // Finally, now that we know we have an identifier, pass this off to the
     // preprocessor, which may macro expand it or something.
@@ -1555,6 +1571,7 @@ FinishIdentifier:
   }
 
   // Otherwise, $,\,? in identifier found.  Enter slower path.
+  HasHash = false;
 
   C = getCharAndSize(CurPtr, Size);
   while (true) {
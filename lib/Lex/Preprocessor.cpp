@@ -578,6 +578,24 @@ IdentifierInfo *Preprocessor::LookUpIdentifierInfo(Token &Identifier) const {
     }
   }
 
+  installIdentifierInfo(Identifier, II);
+  return II;
+}
+
+IdentifierInfo *Preprocessor::LookUpIdentifierInfo(Token &Identifier,
+                                                   unsigned NameHash) const {
+  assert(!Identifier.getRawIdentifier().empty() && "No raw identifier data!");
+  assert(!Identifier.needsCleaning() && !Identifier.hasUCN() &&
+         "Hash of an identifier that needs cleaning!");
+
+  IdentifierInfo *II =
+      &Identifiers.getWithHash(Identifier.getRawIdentifier(), NameHash);
+  installIdentifierInfo(Identifier, II);
+  return II;
+}
+
+void Preprocessor::installIdentifierInfo(Token &Identifier,
+                                         IdentifierInfo *II) const {
   // Update the token info (identifier info and appropriate token kind).
   Identifier.setIdentifierInfo(II);
   if (getLangOpts().MSVCCompat && II->isCPlusPlusOperatorKeyword() &&
@@ -585,8 +603,6 @@ IdentifierInfo *Preprocessor::LookUpIdentifierInfo(Token &Identifier) const {
     Identifier.setKind(clang::tok::identifier);
   else
     Identifier.setKind(II->getTokenID());
-
-  return II;
 }
 
 void Preprocessor::SetPoisonReason(IdentifierInfo *II, unsigned DiagID) {
@@ -36,9 +36,11 @@
 #include "clang/Sema/ScopeInfo.h"
 #include "clang/Sema/SemaConsumer.h"
 #include "clang/Sema/SemaInternal.h"
+#include "clang/Sema/Template.h"
 #include "clang/Sema/TemplateDeduction.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallSet.h"
+#include "llvm/Support/Format.h"
 using namespace clang;
 using namespace sema;
 
@@ -76,7 +78,8 @@ Sema::Sema(Preprocessor &pp, ASTContext &ctxt, ASTConsumer &consumer,
       FPFeatures(pp.getLangOpts()), LangOpts(pp.getLangOpts()), PP(pp),
       Context(ctxt), Consumer(consumer), Diags(PP.getDiagnostics()),
       SourceMgr(PP.getSourceManager()), CollectStats(false),
-      CodeCompleter(CodeCompleter), CurContext(nullptr),
+      DeclarationsOnly(false), CodeCompleter(CodeCompleter),
+      CurContext(nullptr),
       OriginalLexicalContext(nullptr), MSStructPragmaOn(false),
       MSPointerToMemberRepresentationMethod(
           LangOpts.getMSPointerToMemberRepresentationMethod()),
@@ -93,10 +96,13 @@ Sema::Sema(Preprocessor &pp, ASTContext &ctxt, ASTConsumer &consumer,
       ValueWithBytesObjCTypeMethod(nullptr), NSArrayDecl(nullptr),
       ArrayWithObjectsMethod(nullptr), NSDictionaryDecl(nullptr),
       DictionaryWithObjectsMethod(nullptr), GlobalNewDeleteDeclared(false),
-      TUKind(TUKind), NumSFINAEErrors(0), AccessCheckingSFINAE(false),
+      TUKind(TUKind), NumSFINAEErrors(0), NumOverloadResolutions(0),
+      NumOverloadCandidates(0), NumViableOverloadCandidates(0),
+      NumOverloadCandidatesPrefiltered(0), AccessCheckingSFINAE(false),
       InNonInstantiationSFINAEContext(false), NonInstantiationEntries(0),
       ArgumentPackSubstitutionIndex(-1), CurrentInstantiationScope(nullptr),
-      DisableTypoCorrection(false), TyposCorrected(0), AnalysisWarnings(*this),
+      DisableTypoCorrection(false), TyposCorrected(0),
+      TypoCandidateSearchTime(0), AnalysisWarnings(*this),
       ThreadSafetyDeclCache(nullptr), VarDataSharingAttributesStack(nullptr),
       CurScope(nullptr), Ident_super(nullptr), Ident___float128(nullptr) {
   TUScope = nullptr;
@@ -143,6 +149,16 @@ void Sema::Initialize() {
   // will not be able to merge any duplicate __va_list_tag decls correctly.
   VAListTagName = PP.getIdentifierInfo("__va_list_tag");
 
+  // Lazy member instantiation hooks into name lookup as the external AST
+  // source, so it is only available when there is no other one, and no
+  // module can be loaded later on.
+  if (getLangOpts().LazyTemplateMemberInstantiation &&
+      getLangOpts().CPlusPlus && !getLangOpts().Modules &&
+      TUKind == TU_Complete && !Context.getExternalSource()) {
+    LazyMemberSource = new LazyMemberInstantiationSource(*this);
+    Context.setExternalSource(LazyMemberSource);
+  }
+
   if (!TUScope)
     return;
 
@@ -281,6 +297,8 @@ void Sema::Initialize() {
 }
 
 Sema::~Sema() {
+  if (LazyMemberSource)
+    LazyMemberSource->detach();
   if (VisContext) FreeVisContext();
   // Kill all the active scopes.
   for (unsigned I = 1, E = FunctionScopes.size(); I != E; ++I)
@@ -363,6 +381,19 @@ void Sema::addExternalSource(ExternalSemaSource *E) {
 void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
+  llvm::errs() << NumOverloadResolutions << " overload resolutions, "
+               << NumOverloadCandidates << " candidates considered, "
+               << NumViableOverloadCandidates << " viable.\n";
+  llvm::errs() << NumOverloadCandidatesPrefiltered
+               << " overload candidates rejected by first parameter type.\n";
+  llvm::errs() << NumDeducedCallCacheEntries
+               << " function template call deductions cached, "
+               << NumDeducedCallCacheHits << " reused.\n";
+  llvm::errs() << TyposCorrected << " typo corrections attempted.\n";
+  if (TypoIndex)
+    TypoIndex->PrintStats();
+  llvm::errs() << llvm::format("%.4f", TypoCandidateSearchTime)
+               << " seconds searching for typo correction candidates.\n";
 
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
@@ -724,8 +755,11 @@ void Sema::ActOnEndOfTranslationUnit() {
 
     // If DefinedUsedVTables ends up marking any virtual member functions it
     // might lead to more pending template instantiations, which we then need
-    // to instantiate.
-    DefineUsedVTables();
+    // to instantiate. Neither is needed when only declarations are of
+    // interest: the implicit instantiations that declarations depend on, such
+    // as those of constexpr functions, are performed immediately.
+    if (!DeclarationsOnly)
+      DefineUsedVTables();
 
     // C++: Perform implicit template instantiations.
     //
@@ -743,7 +777,8 @@ void Sema::ActOnEndOfTranslationUnit() {
       PendingInstantiations.insert(PendingInstantiations.begin(),
                                    Pending.begin(), Pending.end());
     }
-    PerformPendingInstantiations();
+    if (!DeclarationsOnly)
+      PerformPendingInstantiations();
 
     if (LateTemplateParserCleanup)
       LateTemplateParserCleanup(OpaqueParser);
@@ -800,7 +835,7 @@ void Sema::ActOnEndOfTranslationUnit() {
       !Diags.isIgnored(diag::warn_delegating_ctor_cycle, SourceLocation()))
     CheckDelegatingCtorCycles();
 
-  if (!Diags.hasErrorOccurred()) {
+  if (!Diags.hasErrorOccurred() && !DeclarationsOnly) {
     if (ExternalSource)
       ExternalSource->ReadUndefinedButUsed(UndefinedButUsed);
     checkUndefinedButUsed(*this);
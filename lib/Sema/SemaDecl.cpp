@@ -3049,7 +3049,7 @@ bool Sema::MergeFunctionDecl(FunctionDecl *New, NamedDecl *&OldD,
 
   // If this redeclaration makes the function inline, we may need to add it to
   // UndefinedButUsed.
-  if (!Old->isInlined() && New->isInlined() &&
+  if (!DeclarationsOnly && !Old->isInlined() && New->isInlined() &&
       !New->hasAttr<GNUInlineAttr>() &&
       !getLangOpts().GNUInline &&
       Old->isUsed(false) &&
@@ -3803,8 +3803,9 @@ void Sema::MergeVarDecl(VarDecl *New, LookupResult &Previous) {
 
   // If this redeclaration makes the function inline, we may need to add it to
   // UndefinedButUsed.
-  if (!Old->isInline() && New->isInline() && Old->isUsed(false) &&
-      !Old->getDefinition() && !New->isThisDeclarationADefinition())
+  if (!DeclarationsOnly && !Old->isInline() && New->isInline() &&
+      Old->isUsed(false) && !Old->getDefinition() &&
+      !New->isThisDeclarationADefinition())
     UndefinedButUsed.insert(std::make_pair(Old->getCanonicalDecl(),
                                            SourceLocation()));
 
@@ -11110,8 +11111,11 @@ void Sema::CheckCompleteVariableDeclaration(VarDecl *var) {
       Init && !Init->isValueDependent()) {
 
     if (var->isConstexpr()) {
+      // When only declarations are of interest, the initializer is evaluated
+      // when its value is first needed, if ever, and is not diagnosed.
       SmallVector<PartialDiagnosticAt, 8> Notes;
-      if (!var->evaluateValue(Notes) || !var->isInitICE()) {
+      if (!DeclarationsOnly &&
+          (!var->evaluateValue(Notes) || !var->isInitICE())) {
         SourceLocation DiagLoc = var->getLocation();
         // If the note doesn't add any useful information other than a source
         // location, fold it into the primary diagnostic.
@@ -13741,7 +13741,11 @@ void Sema::MarkFunctionReferenced(SourceLocation Loc, FunctionDecl *Func,
     return;
 
   // Note that this declaration has been used.
-  if (CXXConstructorDecl *Constructor = dyn_cast<CXXConstructorDecl>(Func)) {
+  if (DeclarationsOnly && !Func->isConstexpr()) {
+    // The definition can only be needed by declarations if it can be
+    // evaluated in a constant expression; don't synthesize it.
+  } else if (CXXConstructorDecl *Constructor =
+                 dyn_cast<CXXConstructorDecl>(Func)) {
     Constructor = cast<CXXConstructorDecl>(Constructor->getFirstDecl());
     if (Constructor->isDefaulted() && !Constructor->isDeleted()) {
       if (Constructor->isDefaultConstructor()) {
@@ -13845,8 +13849,10 @@ void Sema::MarkFunctionReferenced(SourceLocation Loc, FunctionDecl *Func,
 
   if (!OdrUse) return;
 
-  // Keep track of used but undefined functions.
-  if (!Func->isDefined()) {
+  // Keep track of used but undefined functions. In declarations-only mode,
+  // the definitions that would be instantiated or synthesized are not, so
+  // there is nothing to check.
+  if (!Func->isDefined() && !DeclarationsOnly) {
     if (mightHaveNonExternalLinkage(Func))
       UndefinedButUsed.insert(std::make_pair(Func->getCanonicalDecl(), Loc));
     else if (Func->getMostRecentDecl()->isInlined() &&
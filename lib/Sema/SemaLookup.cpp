@@ -40,6 +40,9 @@
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/ADT/edit_distance.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Timer.h"
+#include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <iterator>
 #include <list>
@@ -3921,6 +3924,122 @@ void TypoCorrectionConsumer::addName(StringRef Name, NamedDecl *ND,
   addCorrection(TC);
 }
 
+/// \brief Compute the set of characters in \p Name, as a bit per letter,
+/// digit and underscore; all other characters share the last bit.
+///
+/// An edit changes at most one character of each string, so the number of
+/// characters in one string but not in the other is a lower bound on their
+/// edit distance.
+uint64_t TypoCorrectionIndex::getCharSignature(StringRef Name) {
+  uint64_t Chars = 0;
+  for (unsigned char C : Name) {
+    unsigned Bit;
+    if (C >= 'a' && C <= 'z')
+      Bit = C - 'a';
+    else if (C >= 'A' && C <= 'Z')
+      Bit = 26 + (C - 'A');
+    else if (C >= '0' && C <= '9')
+      Bit = 52 + (C - '0');
+    else if (C == '_')
+      Bit = 62;
+    else
+      Bit = 63;
+    Chars |= uint64_t(1) << Bit;
+  }
+  return Chars;
+}
+
+void TypoCorrectionIndex::addName(NamesByLength &Names, StringRef Name) {
+  if (Names.size() <= Name.size())
+    Names.resize(Name.size() + 1);
+  Names[Name.size()].push_back({Name, getCharSignature(Name)});
+}
+
+void TypoCorrectionIndex::update(ASTContext &Context) {
+  // Identifiers are never removed from the identifier table, so after it has
+  // been walked once, only the names added since need to be indexed.
+  if (!TracksLocalNames) {
+    for (const auto &I : Context.Idents)
+      addName(LocalNames, I.getKey());
+    NumLocalNames = Context.Idents.size();
+    Context.Idents.startRecordingAddedNames();
+    TracksLocalNames = true;
+  } else {
+    for (StringRef Name : Context.Idents.takeAddedNames())
+      addName(LocalNames, Name);
+    NumLocalNames = Context.Idents.size();
+  }
+
+  IdentifierInfoLookup *External = Context.Idents.getExternalIdentifierLookup();
+  if (!External) {
+    ExternalNames.clear();
+    NumExternalNames = 0;
+    HasExternalNames = false;
+    return;
+  }
+
+  // The external source only provides more identifiers when it loads more
+  // AST files, which starts a new generation. Without an external AST source
+  // to tell, collect the identifiers again.
+  ExternalASTSource *Source = Context.getExternalSource();
+  if (HasExternalNames && Source &&
+      Source->getGeneration() == ExternalGeneration)
+    return;
+
+  ExternalNames.clear();
+  ExternalNameStorage.Reset();
+  NumExternalNames = 0;
+  std::unique_ptr<IdentifierIterator> Iter(External->getIdentifiers());
+  do {
+    StringRef Name = Iter->Next();
+    if (Name.empty())
+      break;
+
+    addName(ExternalNames, Name.copy(ExternalNameStorage));
+    ++NumExternalNames;
+  } while (true);
+  ExternalGeneration = Source ? Source->getGeneration() : 0;
+  HasExternalNames = true;
+}
+
+void TypoCorrectionIndex::search(const NamesByLength &Names, StringRef Typo,
+                                 llvm::function_ref<void(StringRef)> Found) {
+  // These bounds mirror the checks of TypoCorrectionConsumer::addName(),
+  // which makes the final decision for the names passed to it.
+  unsigned MaxLengthDiff = Typo.size() / 3;
+  unsigned MaxDistance = (Typo.size() + 2) / 3;
+  uint64_t TypoChars = getCharSignature(Typo);
+
+  unsigned MaxLength = Typo.size() + MaxLengthDiff;
+  for (unsigned Length = Typo.size() - MaxLengthDiff;
+       Length <= MaxLength && Length < Names.size(); ++Length) {
+    for (const IndexedName &Name : Names[Length]) {
+      ++NumNamesConsidered;
+      if (llvm::countPopulation(TypoChars & ~Name.Chars) > MaxDistance ||
+          llvm::countPopulation(Name.Chars & ~TypoChars) > MaxDistance) {
+        ++NumNamesRejected;
+        continue;
+      }
+      Found(Name.Name);
+    }
+  }
+}
+
+void TypoCorrectionIndex::findCandidates(
+    StringRef Typo, llvm::function_ref<void(StringRef)> Found) {
+  ++NumSearches;
+  search(LocalNames, Typo, Found);
+  search(ExternalNames, Typo, Found);
+}
+
+void TypoCorrectionIndex::PrintStats() const {
+  llvm::errs() << NumLocalNames << " local and " << NumExternalNames
+               << " external identifiers indexed for typo correction.\n";
+  llvm::errs() << NumSearches << " typo correction candidate searches; "
+               << NumNamesConsidered << " identifiers of similar length, "
+               << NumNamesRejected << " rejected by character signature.\n";
+}
+
 static const unsigned MaxTypoDistanceResultSets = 5;
 
 void TypoCorrectionConsumer::addCorrection(TypoCorrection Correction) {
@@ -4577,24 +4696,17 @@ std::unique_ptr<TypoCorrectionConsumer> Sema::makeTypoCorrectionConsumer(
 
   if (IsUnqualifiedLookup || SearchNamespaces) {
     // For unqualified lookup, look through all of the names that we have
-    // seen in this translation unit.
-    // FIXME: Re-add the ability to skip very unlikely potential corrections.
-    for (const auto &I : Context.Idents)
-      Consumer->FoundName(I.getKey());
-
-    // Walk through identifiers in external identifier sources.
-    // FIXME: Re-add the ability to skip very unlikely potential corrections.
-    if (IdentifierInfoLookup *External
-                            = Context.Idents.getExternalIdentifierLookup()) {
-      std::unique_ptr<IdentifierIterator> Iter(External->getIdentifiers());
-      do {
-        StringRef Name = Iter->Next();
-        if (Name.empty())
-          break;
-
-        Consumer->FoundName(Name);
-      } while (true);
-    }
+    // seen in this translation unit, including those of external identifier
+    // sources. The index skips the names that are too far from the typo.
+    llvm::TimeRecord StartTime = llvm::TimeRecord::getCurrentTime(true);
+    if (!TypoIndex)
+      TypoIndex = llvm::make_unique<TypoCorrectionIndex>();
+    TypoIndex->update(Context);
+    TypoIndex->findCandidates(Typo->getName(), [&](StringRef Name) {
+      Consumer->FoundName(Name);
+    });
+    llvm::TimeRecord EndTime = llvm::TimeRecord::getCurrentTime(false);
+    TypoCandidateSearchTime += EndTime.getWallTime() - StartTime.getWallTime();
   }
 
   AddKeywordsToConsumer(*this, *Consumer, S, CCCRef, SS && SS->isNotEmpty());
@@ -5050,6 +5050,47 @@ TryListConversion(Sema &S, InitListExpr *From, QualType ToType,
   return Result;
 }
 
+/// \brief Determine cheaply whether a parameter of type \p ParamType
+/// certainly cannot bind to the argument \p Arg.
+///
+/// This recognizes a non-const lvalue reference to class type, such as the
+/// stream parameter of an operator<<, with an argument that is of scalar type
+/// or of an unrelated complete class type without conversion functions.
+/// TryReferenceInit() reaches the same no_conversion failure for them, but
+/// only after classifying the argument and building an overload set of its
+/// conversion functions.
+static bool isCertainlyBadReferenceBinding(Expr *Arg, QualType ParamType) {
+  const LValueReferenceType *RefType = ParamType->getAs<LValueReferenceType>();
+  if (!RefType)
+    return false;
+  QualType T1 = RefType->getPointeeType();
+  if ((T1.isConstQualified() && !T1.isVolatileQualified()) ||
+      T1->isDependentType())
+    return false;
+  const CXXRecordDecl *T1RecordDecl = T1->getAsCXXRecordDecl();
+  if (!T1RecordDecl || isa<InitListExpr>(Arg))
+    return false;
+
+  QualType T2 = Arg->getType();
+  if (T2->isDependentType() || T2->isPlaceholderType())
+    return false;
+  if (T2->isScalarType())
+    return true;
+
+  CXXRecordDecl *T2RecordDecl = T2->getAsCXXRecordDecl();
+  if (!T2RecordDecl)
+    return false;
+  // Don't complete the argument type here; leave that to TryReferenceInit().
+  T2RecordDecl = T2RecordDecl->getDefinition();
+  if (!T2RecordDecl || T2RecordDecl->isBeingDefined() ||
+      T2RecordDecl->getCanonicalDecl() == T1RecordDecl->getCanonicalDecl())
+    return false;
+  const auto &Conversions = T2RecordDecl->getVisibleConversionFunctions();
+  if (Conversions.begin() != Conversions.end())
+    return false;
+  return !T2RecordDecl->isDerivedFrom(T1RecordDecl);
+}
+
 /// TryCopyInitialization - Try to copy-initialize a value of type
 /// ToType from the expression From. Return the implicit conversion
 /// sequence required to pass this argument, which may be a bad
@@ -6116,11 +6157,18 @@ Sema::AddOverloadCandidate(FunctionDecl *Function,
         // (13.3.3.1) that converts that argument to the corresponding
         // parameter of F.
         QualType ParamType = Proto->getParamType(ArgIdx);
-        Candidate.Conversions[ArgIdx] = TryCopyInitialization(
-            *this, Args[ArgIdx], ParamType, SuppressUserConversions,
-            /*InOverloadResolution=*/true,
-            /*AllowObjCWritebackConversion=*/
-            getLangOpts().ObjCAutoRefCount, AllowExplicit);
+        if (ArgIdx == 0 &&
+            isCertainlyBadReferenceBinding(Args[ArgIdx], ParamType)) {
+          ++NumOverloadCandidatesPrefiltered;
+          Candidate.Conversions[ArgIdx].setBad(
+              BadConversionSequence::no_conversion, Args[ArgIdx], ParamType);
+        } else {
+          Candidate.Conversions[ArgIdx] = TryCopyInitialization(
+              *this, Args[ArgIdx], ParamType, SuppressUserConversions,
+              /*InOverloadResolution=*/true,
+              /*AllowObjCWritebackConversion=*/
+              getLangOpts().ObjCAutoRefCount, AllowExplicit);
+        }
         if (Candidate.Conversions[ArgIdx].isBad()) {
           Candidate.Viable = false;
           Candidate.FailureKind = ovl_fail_bad_conversion;
@@ -9351,6 +9399,12 @@ OverloadCandidateSet::BestViableFunction(Sema &S, SourceLocation Loc,
   std::transform(begin(), end(), std::back_inserter(Candidates),
                  [](OverloadCandidate &Cand) { return &Cand; });
 
+  ++S.NumOverloadResolutions;
+  S.NumOverloadCandidates += Candidates.size();
+  S.NumViableOverloadCandidates +=
+      llvm::count_if(Candidates,
+                     [](OverloadCandidate *Cand) { return Cand->Viable; });
+
   // [CUDA] HD->H or HD->D calls are technically not allowed by CUDA but
   // are accepted by both clang and NVCC. However, during a particular
   // compilation mode only one call variant is viable. We need to
@@ -3626,6 +3626,48 @@ static Sema::TemplateDeductionResult DeduceTemplateArgumentsFromCallArgument(
                                             ArgType, Info, Deduced, TDF);
 }
 
+/// \brief The maximum number of call arguments for which deductions are
+/// memoized, which keeps cache keys within the inline storage of their node
+/// IDs.
+static const unsigned MaxDeducedCallCacheArgs = 8;
+
+/// \brief Build the key under which the deduction of the template arguments
+/// of \p FunctionTemplate from the call arguments \p Args is memoized.
+///
+/// \returns false if the deduction may depend on more than the types and
+/// value kinds of the arguments, in which case it must not be memoized.
+static bool getDeducedCallCacheKey(Sema &S,
+                                   FunctionTemplateDecl *FunctionTemplate,
+                                   ArrayRef<Expr *> Args,
+                                   llvm::FoldingSetNodeID &ID) {
+  if (Args.size() > MaxDeducedCallCacheArgs)
+    return false;
+
+  // Deductions performed while substituting into another template, or for
+  // templates declared within a function, depend on the state of the
+  // enclosing substitution or instantiation.
+  if (S.isSFINAEContext() ||
+      FunctionTemplate->getDeclContext()->isDependentContext() ||
+      FunctionTemplate->getParentFunctionOrMethod())
+    return false;
+
+  ID.AddPointer(FunctionTemplate);
+  for (Expr *Arg : Args) {
+    // Overload sets, braced-init-lists and incomplete arrays are deduced
+    // from the expression itself, and so are functions, whose prototypes
+    // may be adjusted for designators.
+    QualType ArgType = Arg->getType();
+    if (ArgType->isPlaceholderType() || ArgType->isDependentType() ||
+        isa<InitListExpr>(Arg) || ArgType->isIncompleteArrayType() ||
+        ArgType->isFunctionType() || ArgType->isFunctionPointerType())
+      return false;
+
+    ID.AddPointer(S.Context.getCanonicalType(ArgType).getAsOpaquePtr());
+    ID.AddInteger(Arg->getValueKind());
+  }
+  return true;
+}
+
 /// \brief Perform template argument deduction from a function call
 /// (C++ [temp.deduct.call]).
 ///
@@ -3664,6 +3706,27 @@ Sema::DeduceTemplateArguments(FunctionTemplateDecl *FunctionTemplate,
   if (FunctionTemplate->isInvalidDecl())
     return TDK_Invalid;
 
+  // Deduction without explicit template arguments only depends on the types
+  // and value kinds of the arguments, so reuse the result of an identical
+  // earlier deduction if there is one.
+  llvm::FoldingSetNodeID CacheID;
+  bool UseCache =
+      !ExplicitTemplateArgs && !HasDesig && !PartialOverloading &&
+      getDeducedCallCacheKey(*this, FunctionTemplate, Args, CacheID);
+  if (UseCache) {
+    void *InsertPos;
+    if (DeducedCallCacheEntry *Entry =
+            DeducedCallCache.FindNodeOrInsertPos(CacheID, InsertPos)) {
+      // A specialization can be invalidated after the fact; deduce again.
+      if (!Entry->getSpecialization()->isInvalidDecl()) {
+        ++NumDeducedCallCacheHits;
+        return FinishCachedTemplateArgumentDeduction(
+            FunctionTemplate, *Entry, Specialization, Info, CheckNonDependent);
+      }
+      DeducedCallCache.RemoveNode(Entry);
+    }
+  }
+
   FunctionDecl *Function = FunctionTemplate->getTemplatedDecl();
   const FunctionProtoType *Proto =
       Function->getType()->getAs<FunctionProtoType>();
@@ -3902,10 +3965,70 @@ Sema::DeduceTemplateArguments(FunctionTemplateDecl *FunctionTemplate,
       return Result;
   }
 
-  return FinishTemplateArgumentDeduction(
+  TemplateDeductionResult Result = FinishTemplateArgumentDeduction(
       FunctionTemplate, Deduced, NumExplicitlySpecified, Specialization, Info,
       &OriginalCallArgs, PartialOverloading,
       [&]() { return CheckNonDependent(ParamTypesForArgChecking); });
+  if (Result || !UseCache)
+    return Result;
+
+  // Deduction may have added entries to the cache; look for the insertion
+  // position again.
+  void *InsertPos;
+  if (!DeducedCallCache.FindNodeOrInsertPos(CacheID, InsertPos)) {
+    QualType *ParamTypes =
+        BumpAlloc.Allocate<QualType>(ParamTypesForArgChecking.size());
+    std::copy(ParamTypesForArgChecking.begin(), ParamTypesForArgChecking.end(),
+              ParamTypes);
+    DeducedCallCacheEntry *Entry =
+        new (BumpAlloc.Allocate<DeducedCallCacheEntry>()) DeducedCallCacheEntry(
+            CacheID, Specialization,
+            llvm::makeArrayRef(ParamTypes, ParamTypesForArgChecking.size()));
+    DeducedCallCache.InsertNode(Entry, InsertPos);
+    ++NumDeducedCallCacheEntries;
+  }
+  return TDK_Success;
+}
+
+/// \brief Finish a template argument deduction for a call that was satisfied
+/// by the DeducedCallCache.
+///
+/// Only the conversions of the arguments for non-dependent parameters need
+/// to be checked again, since they depend on the arguments themselves (a
+/// null pointer constant converts where another integer does not). They are
+/// checked in the same context as FinishTemplateArgumentDeduction() does.
+Sema::TemplateDeductionResult Sema::FinishCachedTemplateArgumentDeduction(
+    FunctionTemplateDecl *FunctionTemplate, DeducedCallCacheEntry &Entry,
+    FunctionDecl *&Specialization, TemplateDeductionInfo &Info,
+    llvm::function_ref<bool(ArrayRef<QualType>)> CheckNonDependent) {
+  // Unevaluated SFINAE context.
+  EnterExpressionEvaluationContext Unevaluated(
+      *this, Sema::ExpressionEvaluationContext::Unevaluated);
+  SFINAETrap Trap(*this);
+
+  FunctionDecl *Cached = Entry.getSpecialization();
+  ArrayRef<TemplateArgument> DeducedArgs =
+      Cached->getTemplateSpecializationArgs()->asArray();
+  InstantiatingTemplate Inst(
+      *this, Info.getLocation(), FunctionTemplate, DeducedArgs,
+      CodeSynthesisContext::DeducedTemplateArgumentSubstitution, Info);
+  if (Inst.isInvalid())
+    return TDK_InstantiationDepth;
+
+  ContextRAII SavedContext(*this, FunctionTemplate->getTemplatedDecl());
+
+  if (CheckNonDependent(Entry.getParamTypesForArgChecking()))
+    return TDK_NonDependentConversionFailure;
+
+  Info.reset(TemplateArgumentList::CreateCopy(Context, DeducedArgs));
+
+  if (Trap.hasErrorOccurred()) {
+    Cached->setInvalidDecl(true);
+    return TDK_SubstitutionFailure;
+  }
+
+  Specialization = Cached;
+  return TDK_Success;
 }
 
 QualType Sema::adjustCCAndNoReturn(QualType ArgFunctionType,
@@ -16,6 +16,7 @@
 #include "clang/AST/ASTContext.h"
 #include "clang/AST/ASTLambda.h"
 #include "clang/AST/ASTMutationListener.h"
+#include "clang/AST/DeclContextInternals.h"
 #include "clang/AST/DeclTemplate.h"
 #include "clang/AST/Expr.h"
 #include "clang/Basic/LangOptions.h"
@@ -2197,6 +2198,17 @@ Sema::InstantiateClass(SourceLocation PointOfInstantiation,
   LateInstantiatedAttrVec LateAttrs;
   Instantiator.enableLateAttributeInstantiation(&LateAttrs);
 
+  // With -flazy-template-member-instantiation, the declarations of some
+  // member functions are only instantiated once their name is looked up.
+  bool DeferMembers =
+      LazyMemberSource && TSK == TSK_ImplicitInstantiation &&
+      !Instantiation->isInvalidDecl() &&
+      LazyMemberInstantiationSource::canDeferMembers(Instantiation);
+  llvm::DenseSet<DeclarationName> DeferrableNames;
+  if (DeferMembers)
+    LazyMemberInstantiationSource::collectDeferrableNames(Pattern,
+                                                          DeferrableNames);
+
   for (auto *Member : Pattern->decls()) {
     // Don't instantiate members not belonging in this semantic context.
     // e.g. for:
@@ -2215,6 +2227,11 @@ Sema::InstantiateClass(SourceLocation PointOfInstantiation,
       continue;
     }
 
+    if (DeferMembers &&
+        LazyMemberSource->deferMember(Instantiation, Member, DeferrableNames,
+                                      TemplateArgs, PointOfInstantiation))
+      continue;
+
     Decl *NewMember = Instantiator.Visit(Member);
     if (NewMember) {
       if (FieldDecl *Field = dyn_cast<FieldDecl>(NewMember)) {
@@ -2341,6 +2358,142 @@ Sema::InstantiateClass(SourceLocation PointOfInstantiation,
   return Instantiation->isInvalidDecl();
 }
 
+bool LazyMemberInstantiationSource::canDeferMembers(
+    const CXXRecordDecl *Instantiation) {
+  // Members of local classes are instantiated within the instantiation scope
+  // of their enclosing function. A member function of a class with a
+  // polymorphic base may override a virtual function, which is only known
+  // once it is instantiated. All the members of a dllexported class are
+  // emitted, so they are needed anyway.
+  return Instantiation->isDefinedOutsideFunctionOrMethod() &&
+         !Instantiation->isPolymorphic() &&
+         !Instantiation->hasAttr<DLLExportAttr>();
+}
+
+/// \brief Determine whether \p Member, a member of a class template pattern,
+/// is a member function that nothing but name lookup can find.
+static bool isDeferrableMember(const Decl *Member) {
+  const Decl *D = Member;
+  if (const auto *FunTmpl = dyn_cast<FunctionTemplateDecl>(Member))
+    D = FunTmpl->getTemplatedDecl();
+  const auto *Method = dyn_cast<CXXMethodDecl>(D);
+  return Method && Method->getDeclName().isIdentifier() &&
+         !Method->isVirtualAsWritten() && !Method->hasAttrs() &&
+         !Member->hasAttrs();
+}
+
+void LazyMemberInstantiationSource::collectDeferrableNames(
+    const CXXRecordDecl *Pattern, llvm::DenseSet<DeclarationName> &Names) {
+  // A member that is instantiated eagerly ends up in the lookup table of the
+  // instantiation, which then answers lookups of its name without asking
+  // the external source. Any deferred member with the same name, e.g. an
+  // overload or a function hiding a using-declaration, would be missed.
+  llvm::DenseSet<DeclarationName> EagerNames;
+  for (const Decl *Member : Pattern->decls()) {
+    const auto *ND = dyn_cast<NamedDecl>(Member);
+    if (!ND || !ND->getDeclName())
+      continue;
+    if (isDeferrableMember(Member))
+      Names.insert(ND->getDeclName());
+    else
+      EagerNames.insert(ND->getDeclName());
+  }
+  for (DeclarationName Name : EagerNames)
+    Names.erase(Name);
+}
+
+bool LazyMemberInstantiationSource::deferMember(
+    CXXRecordDecl *Instantiation, Decl *Member,
+    const llvm::DenseSet<DeclarationName> &DeferrableNames,
+    const MultiLevelTemplateArgumentList &TemplateArgs,
+    SourceLocation PointOfInstantiation) {
+  auto *ND = dyn_cast<NamedDecl>(Member);
+  if (!ND || !isDeferrableMember(Member) ||
+      !DeferrableNames.count(ND->getDeclName()))
+    return false;
+
+  // If the name was already looked up in the instantiation, the lookup table
+  // would not ask for it again; instantiate the member right away.
+  DeclarationName Name = ND->getDeclName();
+  if (StoredDeclsMap *Map = Instantiation->getLookupPtr())
+    if (Map->count(Name))
+      return false;
+
+  auto Inserted = Pending.insert({Instantiation, PendingMembers()});
+  PendingMembers &Entry = Inserted.first->second;
+  if (Inserted.second) {
+    Entry.TemplateArgs = TemplateArgs;
+    Entry.PointOfInstantiation = PointOfInstantiation;
+    Instantiation->setHasExternalVisibleStorage();
+  }
+  Entry.Members.push_back(cast<NamedDecl>(Member));
+  ++NumMembersDeferred;
+  return true;
+}
+
+bool LazyMemberInstantiationSource::instantiate(
+    const CXXRecordDecl *Record, llvm::function_ref<bool(NamedDecl *)> Filter) {
+  if (!SemaRef)
+    return false;
+  auto Pos = Pending.find(Record);
+  if (Pos == Pending.end())
+    return false;
+
+  // Take the members out of the pending list first: instantiating them can
+  // look up their names again, and defer members of other classes.
+  SmallVector<NamedDecl *, 4> Members;
+  llvm::erase_if(Pos->second.Members, [&](NamedDecl *Member) {
+    if (!Filter(Member))
+      return false;
+    Members.push_back(Member);
+    return true;
+  });
+  if (Members.empty())
+    return false;
+  MultiLevelTemplateArgumentList TemplateArgs = Pos->second.TemplateArgs;
+  SourceLocation PointOfInstantiation = Pos->second.PointOfInstantiation;
+  if (Pos->second.Members.empty())
+    Pending.erase(Pos);
+
+  // Instantiate the members as InstantiateClass() would have.
+  Sema &S = *SemaRef;
+  CXXRecordDecl *Instantiation = const_cast<CXXRecordDecl *>(Record);
+  Sema::InstantiatingTemplate Inst(S, PointOfInstantiation, Instantiation);
+  if (Inst.isInvalid())
+    return false;
+  Sema::ContextRAII SavedContext(S, Instantiation);
+  EnterExpressionEvaluationContext EvalContext(
+      S, Sema::ExpressionEvaluationContext::PotentiallyEvaluated);
+  LocalInstantiationScope Scope(S);
+  TemplateDeclInstantiator Instantiator(S, Instantiation, TemplateArgs);
+  for (NamedDecl *Member : Members)
+    Instantiator.Visit(Member);
+  NumMembersInstantiated += Members.size();
+  return true;
+}
+
+bool LazyMemberInstantiationSource::FindExternalVisibleDeclsByName(
+    const DeclContext *DC, DeclarationName Name) {
+  const auto *Record = dyn_cast<CXXRecordDecl>(DC);
+  if (!Record)
+    return false;
+  return instantiate(Record, [&](NamedDecl *Member) {
+    return Member->getDeclName() == Name;
+  });
+}
+
+void LazyMemberInstantiationSource::completeVisibleDeclsMap(
+    const DeclContext *DC) {
+  if (const auto *Record = dyn_cast<CXXRecordDecl>(DC))
+    instantiateAll(Record);
+}
+
+void LazyMemberInstantiationSource::PrintStats() {
+  llvm::errs() << "*** Lazy Template Member Instantiation Stats:\n";
+  llvm::errs() << NumMembersDeferred << " member declarations deferred, "
+               << NumMembersInstantiated << " later instantiated.\n";
+}
+
 /// \brief Instantiate the definition of an enum from a given pattern.
 ///
 /// \param PointOfInstantiation The point of instantiation within the
@@ -2686,6 +2839,10 @@ Sema::InstantiateClassMembers(SourceLocation PointOfInstantiation,
        TSK == TSK_ExplicitInstantiationDeclaration ||
        (TSK == TSK_ImplicitInstantiation && Instantiation->isLocalClass())) &&
       "Unexpected template specialization kind!");
+  // Explicit instantiations instantiate every member.
+  if (LazyMemberSource)
+    LazyMemberSource->instantiateAll(Instantiation);
+
   for (auto *D : Instantiation->decls()) {
     bool SuppressNew = false;
     if (auto *Function = dyn_cast<FunctionDecl>(D)) {
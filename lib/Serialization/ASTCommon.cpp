@@ -17,6 +17,7 @@
 #include "clang/Basic/IdentifierTable.h"
 #include "clang/Serialization/ASTDeserializationListener.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/MathExtras.h"
 
 using namespace clang;
 
@@ -172,6 +173,71 @@ unsigned serialization::ComputeHash(Selector Sel) {
   return R;
 }
 
+/// The size of a block of the identifier filter, in bytes.
+static const unsigned IdentifierFilterBlockSize = 64;
+
+/// The number of filter bits per identifier.
+static const unsigned IdentifierFilterBitsPerKey = 10;
+
+/// The number of bits set in its block by each identifier.
+static const unsigned IdentifierFilterNumProbes = 5;
+
+/// The maximum number of blocks in an identifier filter. The block index
+/// is taken from the bits of the mixed hash that the probes do not use.
+static const unsigned MaxIdentifierFilterBlocks = 1U << 19;
+
+/// \brief Spread the identifier hash over 64 bits. The low 45 bits select
+/// the bits to probe within a block and the high 19 bits select the block.
+static uint64_t mixIdentifierHash(unsigned NameHash) {
+  uint64_t X = NameHash;
+  X ^= X >> 33;
+  X *= 0xff51afd7ed558ccdULL;
+  X ^= X >> 33;
+  X *= 0xc4ceb9fe1a85ec53ULL;
+  X ^= X >> 33;
+  return X;
+}
+
+unsigned serialization::getIdentifierFilterSize(unsigned NumIdentifiers) {
+  const uint64_t BlockBits = IdentifierFilterBlockSize * 8;
+  uint64_t NumBits = (uint64_t)NumIdentifiers * IdentifierFilterBitsPerKey;
+  uint64_t NumBlocks = (NumBits + BlockBits - 1) / BlockBits;
+  NumBlocks = llvm::PowerOf2Ceil(std::max<uint64_t>(NumBlocks, 1));
+  NumBlocks = std::min<uint64_t>(NumBlocks, MaxIdentifierFilterBlocks);
+  return NumBlocks * IdentifierFilterBlockSize;
+}
+
+bool serialization::isValidIdentifierFilterSize(size_t Size) {
+  return Size != 0 && Size % IdentifierFilterBlockSize == 0 &&
+         Size / IdentifierFilterBlockSize <= MaxIdentifierFilterBlocks &&
+         llvm::isPowerOf2_64(Size / IdentifierFilterBlockSize);
+}
+
+void serialization::addToIdentifierFilter(MutableArrayRef<unsigned char> Filter,
+                                          unsigned NameHash) {
+  assert(isValidIdentifierFilterSize(Filter.size()) && "Bad filter size");
+  uint64_t Mixed = mixIdentifierHash(NameHash);
+  unsigned NumBlocks = Filter.size() / IdentifierFilterBlockSize;
+  unsigned char *Block = Filter.data() + ((Mixed >> 45) & (NumBlocks - 1)) *
+                                             IdentifierFilterBlockSize;
+  for (unsigned I = 0; I != IdentifierFilterNumProbes; ++I, Mixed >>= 9)
+    Block[(Mixed & 511) / 8] |= 1 << (Mixed & 7);
+}
+
+bool serialization::identifierFilterMayContain(ArrayRef<unsigned char> Filter,
+                                               unsigned NameHash) {
+  assert(isValidIdentifierFilterSize(Filter.size()) && "Bad filter size");
+  uint64_t Mixed = mixIdentifierHash(NameHash);
+  unsigned NumBlocks = Filter.size() / IdentifierFilterBlockSize;
+  const unsigned char *Block =
+      Filter.data() +
+      ((Mixed >> 45) & (NumBlocks - 1)) * IdentifierFilterBlockSize;
+  for (unsigned I = 0; I != IdentifierFilterNumProbes; ++I, Mixed >>= 9)
+    if (!(Block[(Mixed & 511) / 8] & (1 << (Mixed & 7))))
+      return false;
+  return true;
+}
+
 const DeclContext *
 serialization::getDefinitiveDeclContext(const DeclContext *DC) {
   switch (DC->getDeclKind()) {
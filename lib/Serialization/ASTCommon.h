@@ -71,6 +71,29 @@ TypeID MakeTypeID(ASTContext &Context, QualType T, IdxForTypeTy IdxForType) {
 
 unsigned ComputeHash(Selector Sel);
 
+/// \brief Compute the size, in bytes, of the identifier filter for an
+/// identifier table with \p NumIdentifiers entries.
+///
+/// The identifier filter is a blocked Bloom filter over the hashes of the
+/// identifiers in a module file's identifier table: each identifier sets a
+/// few bits within a single 64-byte block, so a lookup of an identifier
+/// that is not in the table is usually rejected by reading one block,
+/// without probing the table itself.
+unsigned getIdentifierFilterSize(unsigned NumIdentifiers);
+
+/// \brief Add the identifier with hash \p NameHash to the identifier
+/// filter \p Filter.
+void addToIdentifierFilter(MutableArrayRef<unsigned char> Filter,
+                           unsigned NameHash);
+
+/// \brief Determine whether the identifier with hash \p NameHash may be
+/// in the identifier table summarized by \p Filter.
+bool identifierFilterMayContain(ArrayRef<unsigned char> Filter,
+                                unsigned NameHash);
+
+/// \brief Determine whether \p Size is a valid identifier filter size.
+bool isValidIdentifierFilterSize(size_t Size);
+
 /// \brief Retrieve the "definitive" declaration that provides all of the
 /// visible entries for the given declaration context, if there is one.
 ///
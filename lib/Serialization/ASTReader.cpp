@@ -36,6 +36,7 @@
 #include "clang/Basic/ExceptionSpecificationType.h"
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/FileSystemOptions.h"
+#include "clang/Basic/FileSystemStatCache.h"
 #include "clang/Basic/LangOptions.h"
 #include "clang/Basic/MemoryBufferCache.h"
 #include "clang/Basic/ObjCRuntime.h"
@@ -1136,7 +1137,25 @@ bool ASTReader::ReadVisibleDeclContextStorage(ModuleFile &M,
   StringRef Blob;
   unsigned Code = Cursor.ReadCode();
   unsigned RecCode = Cursor.readRecord(Code, Record, &Blob);
-  if (RecCode != DECL_CONTEXT_VISIBLE) {
+  if (RecCode == DECL_CONTEXT_VISIBLE_COMPRESSED) {
+    if (!llvm::zlib::isAvailable()) {
+      Error("zlib is not available");
+      return true;
+    }
+    SmallString<0> Uncompressed;
+    if (llvm::Error E = llvm::zlib::uncompress(Blob, Uncompressed, Record[0])) {
+      Error("could not decompress lookup table: " +
+            llvm::toString(std::move(E)));
+      return true;
+    }
+    ++NumLookupTablesDecompressed;
+    CompressedLookupTableBytes += Blob.size();
+    DecompressedLookupTableBytes += Uncompressed.size();
+    // The table has to live as long as the module file.
+    M.DecompressedLookupTables.push_back(
+        llvm::MemoryBuffer::getMemBufferCopy(Uncompressed));
+    Blob = M.DecompressedLookupTables.back()->getBuffer();
+  } else if (RecCode != DECL_CONTEXT_VISIBLE) {
     Error("Expected visible lookup table block");
     return true;
   }
@@ -1816,18 +1835,24 @@ namespace {
     unsigned PriorGeneration;
     unsigned &NumIdentifierLookups;
     unsigned &NumIdentifierLookupHits;
+    unsigned &NumIdentifierFilterRejections;
     IdentifierInfo *Found;
 
   public:
-    IdentifierLookupVisitor(StringRef Name, unsigned PriorGeneration,
+    IdentifierLookupVisitor(StringRef Name, unsigned NameHash,
+                            unsigned PriorGeneration,
                             unsigned &NumIdentifierLookups,
-                            unsigned &NumIdentifierLookupHits)
-      : Name(Name), NameHash(ASTIdentifierLookupTrait::ComputeHash(Name)),
+                            unsigned &NumIdentifierLookupHits,
+                            unsigned &NumIdentifierFilterRejections)
+      : Name(Name), NameHash(NameHash),
         PriorGeneration(PriorGeneration),
         NumIdentifierLookups(NumIdentifierLookups),
         NumIdentifierLookupHits(NumIdentifierLookupHits),
+        NumIdentifierFilterRejections(NumIdentifierFilterRejections),
         Found()
     {
+      assert(NameHash == ASTIdentifierLookupTrait::ComputeHash(Name) &&
+             "Wrong identifier hash!");
     }
 
     bool operator()(ModuleFile &M) {
@@ -1840,6 +1865,15 @@ namespace {
       if (!IdTable)
         return false;
 
+      // Most identifiers are in few of the loaded files; let the filter
+      // reject this one before we touch the hash table.
+      if (!M.IdentifierFilter.empty() &&
+          !serialization::identifierFilterMayContain(M.IdentifierFilter,
+                                                     NameHash)) {
+        ++NumIdentifierFilterRejections;
+        return false;
+      }
+
       ASTIdentifierLookupTrait Trait(IdTable->getInfoObj().getReader(), M,
                                      Found);
       ++NumIdentifierLookups;
@@ -1871,19 +1905,24 @@ void ASTReader::updateOutOfDateIdentifier(IdentifierInfo &II) {
   if (getContext().getLangOpts().Modules)
     PriorGeneration = IdentifierGeneration[&II];
 
+  // Hash the name once for both the global index and the module files.
+  StringRef Name = II.getName();
+  unsigned NameHash = ASTIdentifierLookupTrait::ComputeHash(Name);
+
   // If there is a global index, look there first to determine which modules
   // provably do not have any results for this identifier.
   GlobalModuleIndex::HitSet Hits;
   GlobalModuleIndex::HitSet *HitsPtr = nullptr;
   if (!loadGlobalIndex()) {
-    if (GlobalIndex->lookupIdentifier(II.getName(), Hits)) {
+    if (GlobalIndex->lookupIdentifier(Name, NameHash, Hits)) {
       HitsPtr = &Hits;
     }
   }
 
-  IdentifierLookupVisitor Visitor(II.getName(), PriorGeneration,
+  IdentifierLookupVisitor Visitor(Name, NameHash, PriorGeneration,
                                   NumIdentifierLookups,
-                                  NumIdentifierLookupHits);
+                                  NumIdentifierLookupHits,
+                                  NumIdentifierFilterRejections);
   ModuleMgr.visit(Visitor, HitsPtr);
   markIdentifierUpToDate(&II);
 }
@@ -2166,6 +2205,46 @@ InputFile ASTReader::getInputFile(ModuleFile &F, unsigned ID, bool Complain) {
   return IF;
 }
 
+/// \brief The minimum number of input files that are not yet known to the
+/// file manager for them to be stat'ed in a parallel batch.
+static const unsigned MinInputFilesToPrefetch = 32;
+
+/// \brief The number of threads used to stat input files. Stats are bound by
+/// file system latency rather than CPU time, so this does not depend on the
+/// number of cores.
+static const unsigned InputFilePrefetchThreads = 8;
+
+PrefetchedStatCache *ASTReader::prefetchInputFileStats(ModuleFile &F,
+                                                       unsigned N) {
+  // Only the real file system can be stat'ed from several threads; any other
+  // one is left to the usual one-at-a-time validation.
+  if (FileMgr.getVirtualFileSystem() != vfs::getRealFileSystem())
+    return nullptr;
+
+  std::vector<std::string> Paths;
+  for (unsigned I = 0; I < N; ++I) {
+    if (F.InputFilesLoaded[I].getFile() || F.InputFilesLoaded[I].isNotFound())
+      continue;
+    InputFileInfo FI = readInputFileInfo(F, I+1);
+    if (FileMgr.isKnownFile(FI.Filename))
+      continue;
+    // Stat the path exactly as the file manager will.
+    SmallString<128> Path(FI.Filename);
+    FileMgr.FixupRelativePath(Path);
+    Paths.push_back(Path.str());
+  }
+  if (Paths.size() < MinInputFilesToPrefetch)
+    return nullptr;
+
+  auto Cache = llvm::make_unique<PrefetchedStatCache>();
+  Cache->prefetch(Paths, *FileMgr.getVirtualFileSystem(),
+                  InputFilePrefetchThreads);
+  NumInputFileStatsPrefetched += Paths.size();
+  PrefetchedStatCache *Result = Cache.get();
+  FileMgr.addStatCache(std::move(Cache));
+  return Result;
+}
+
 /// \brief If we are loading a relocatable PCH or module file, and the filename
 /// is not an absolute path, add the system or module root to the beginning of
 /// the file name.
@@ -2340,11 +2419,26 @@ ASTReader::ReadControlBlock(ModuleFile &F,
              F.Kind == MK_ImplicitModule))
           N = NumInputs;
 
+        llvm::TimeRecord ValidationStart = llvm::TimeRecord::getCurrentTime();
+        PrefetchedStatCache *Prefetched = prefetchInputFileStats(F, N);
+
+        bool IsOutOfDate = false;
         for (unsigned I = 0; I < N; ++I) {
           InputFile IF = getInputFile(F, I+1, Complain);
-          if (!IF.getFile() || IF.isOutOfDate())
-            return OutOfDate;
+          ++NumInputFilesValidated;
+          if (!IF.getFile() || IF.isOutOfDate()) {
+            IsOutOfDate = true;
+            break;
+          }
         }
+
+        if (Prefetched)
+          FileMgr.removeStatCache(Prefetched);
+        llvm::TimeRecord Elapsed = llvm::TimeRecord::getCurrentTime(false);
+        Elapsed -= ValidationStart;
+        InputFileValidationTime += Elapsed;
+        if (IsOutOfDate)
+          return OutOfDate;
       }
 
       if (Listener)
@@ -2803,6 +2897,13 @@ ASTReader::ReadASTBlock(ModuleFile &F, unsigned ClientLoadCapabilities) {
       }
       break;
 
+    case IDENTIFIER_FILTER:
+      // The filter only speeds up lookups; ignore one we cannot use.
+      if (serialization::isValidIdentifierFilterSize(Blob.size()))
+        F.IdentifierFilter = llvm::makeArrayRef(
+            reinterpret_cast<const unsigned char *>(Blob.data()), Blob.size());
+      break;
+
     case IDENTIFIER_OFFSET: {
       if (F.LocalNumIdentifiers != 0) {
         Error("duplicate IDENTIFIER_OFFSET record in AST file");
@@ -5690,6 +5791,9 @@ void ASTReader::ReadPragmaDiagnosticMappings(DiagnosticsEngine &Diag) {
     // Don't try to read these mappings again.
     Record.clear();
   }
+
+  // The new states may enable diagnostics that were disabled everywhere.
+  Diag.invalidateNeverEnabled();
 }
 
 /// \brief Get the correct cursor and offset for loading a type.
@@ -7397,6 +7501,16 @@ void ASTReader::PrintStats() {
                  NumVisibleDeclContextsRead, TotalVisibleDeclContexts,
                  ((float)NumVisibleDeclContextsRead/TotalVisibleDeclContexts
                   * 100));
+  if (NumLookupTablesDecompressed)
+    std::fprintf(stderr, "  %u lookup tables decompressed (%llu bytes to "
+                 "%llu bytes)\n", NumLookupTablesDecompressed,
+                 (unsigned long long)CompressedLookupTableBytes,
+                 (unsigned long long)DecompressedLookupTableBytes);
+  if (NumInputFilesValidated)
+    std::fprintf(stderr, "  %u input files validated (%u stat'ed in parallel) "
+                 "in %.4f seconds\n", NumInputFilesValidated,
+                 NumInputFileStatsPrefetched,
+                 InputFileValidationTime.getWallTime());
   if (TotalNumMethodPoolEntries) {
     std::fprintf(stderr, "  %u/%u method pool entries read (%f%%)\n",
                  NumMethodPoolEntriesRead, TotalNumMethodPoolEntries,
@@ -7421,6 +7535,15 @@ void ASTReader::PrintStats() {
                  NumIdentifierLookupHits, NumIdentifierLookups,
                  (double)NumIdentifierLookupHits*100.0/NumIdentifierLookups);
   }
+  if (NumIdentifierFilterRejections) {
+    unsigned TotalLookups =
+        NumIdentifierLookups + NumIdentifierFilterRejections;
+    std::fprintf(stderr,
+                 "  %u / %u identifier table lookups rejected by identifier "
+                 "filters (%f%%)\n",
+                 NumIdentifierFilterRejections, TotalLookups,
+                 (double)NumIdentifierFilterRejections*100.0/TotalLookups);
+  }
 
   if (GlobalIndex) {
     std::fprintf(stderr, "\n");
@@ -7572,12 +7695,17 @@ void ASTReader::UpdateSema() {
 }
 
 IdentifierInfo *ASTReader::get(StringRef Name) {
+  return getWithHash(Name, ASTIdentifierLookupTrait::ComputeHash(Name));
+}
+
+IdentifierInfo *ASTReader::getWithHash(StringRef Name, unsigned NameHash) {
   // Note that we are loading an identifier.
   Deserializing AnIdentifier(this);
 
-  IdentifierLookupVisitor Visitor(Name, /*PriorGeneration=*/0,
+  IdentifierLookupVisitor Visitor(Name, NameHash, /*PriorGeneration=*/0,
                                   NumIdentifierLookups,
-                                  NumIdentifierLookupHits);
+                                  NumIdentifierLookupHits,
+                                  NumIdentifierFilterRejections);
 
   // We don't need to do identifier table lookups in C++ modules (we preload
   // all interesting declarations, and don't need to use the scope for name
@@ -7593,7 +7721,7 @@ IdentifierInfo *ASTReader::get(StringRef Name) {
     GlobalModuleIndex::HitSet Hits;
     GlobalModuleIndex::HitSet *HitsPtr = nullptr;
     if (!loadGlobalIndex()) {
-      if (GlobalIndex->lookupIdentifier(Name, Hits)) {
+      if (GlobalIndex->lookupIdentifier(Name, NameHash, Hits)) {
         HitsPtr = &Hits;
       }
     }
@@ -81,6 +81,7 @@
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/SHA1.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
@@ -90,6 +91,7 @@
 #include <deque>
 #include <limits>
 #include <new>
+#include <thread>
 #include <tuple>
 #include <utility>
 
@@ -1099,6 +1101,7 @@ void ASTWriter::WriteBlockInfoBlock() {
   RECORD(DELETE_EXPRS_TO_ANALYZE);
   RECORD(CUDA_PRAGMA_FORCE_HOST_DEVICE_DEPTH);
   RECORD(PP_CONDITIONAL_STACK);
+  RECORD(IDENTIFIER_FILTER);
 
   // SourceManager Block.
   BLOCK(SOURCE_MANAGER_BLOCK);
@@ -1254,6 +1257,7 @@ void ASTWriter::WriteBlockInfoBlock() {
   RECORD(DECL_PRAGMA_COMMENT);
   RECORD(DECL_PRAGMA_DETECT_MISMATCH);
   RECORD(DECL_OMP_DECLARE_REDUCTION);
+  RECORD(DECL_CONTEXT_VISIBLE_COMPRESSED);
   
   // Statements and Exprs can occur in the Decls and Types block.
   AddStmtsExprs(Stream, Record);
@@ -2122,30 +2126,116 @@ void ASTWriter::WriteHeaderSearch(const HeaderSearch &HS) {
     free(const_cast<char *>(SavedStrings[I]));
 }
 
+namespace {
+
+/// \brief The compressed form of a buffer embedded in the AST file.
+struct CompressedBlob {
+  SmallString<0> Data;
+  /// Whether compression succeeded; otherwise the buffer is stored as is.
+  bool Compressed = false;
+};
+
+} // end anonymous namespace
+
+/// \brief Compress the buffer \p Blob, which includes its terminating null
+/// character.
+static void compressBlob(StringRef Blob, CompressedBlob &Result) {
+  if (!llvm::zlib::isAvailable())
+    return;
+  llvm::Error E = llvm::zlib::compress(Blob.drop_back(1), Result.Data);
+  if (!E) {
+    Result.Compressed = true;
+    return;
+  }
+  llvm::consumeError(std::move(E));
+  Result.Data.clear();
+}
+
 static void emitBlob(llvm::BitstreamWriter &Stream, StringRef Blob,
+                     const CompressedBlob *Compressed,
                      unsigned SLocBufferBlobCompressedAbbrv,
                      unsigned SLocBufferBlobAbbrv) {
   typedef ASTWriter::RecordData::value_type RecordDataType;
 
-  // Compress the buffer if possible. We expect that almost all PCM
+  // Emit the compressed buffer if possible. We expect that almost all PCM
   // consumers will not want its contents.
-  SmallString<0> CompressedBuffer;
-  if (llvm::zlib::isAvailable()) {
-    llvm::Error E = llvm::zlib::compress(Blob.drop_back(1), CompressedBuffer);
-    if (!E) {
-      RecordDataType Record[] = {SM_SLOC_BUFFER_BLOB_COMPRESSED,
-                                 Blob.size() - 1};
-      Stream.EmitRecordWithBlob(SLocBufferBlobCompressedAbbrv, Record,
-                                CompressedBuffer);
-      return;
-    }
-    llvm::consumeError(std::move(E));
+  if (Compressed && Compressed->Compressed) {
+    RecordDataType Record[] = {SM_SLOC_BUFFER_BLOB_COMPRESSED,
+                               Blob.size() - 1};
+    Stream.EmitRecordWithBlob(SLocBufferBlobCompressedAbbrv, Record,
+                              Compressed->Data);
+    return;
   }
 
   RecordDataType Record[] = {SM_SLOC_BUFFER_BLOB};
   Stream.EmitRecordWithBlob(SLocBufferBlobAbbrv, Record, Blob);
 }
 
+/// \brief Whether the contents of the file or buffer \p Content are
+/// embedded in the AST file.
+static bool isEmbeddedBuffer(const SrcMgr::ContentCache *Content) {
+  return !Content->OrigEntry || Content->BufferOverridden ||
+         Content->IsTransient;
+}
+
+/// \brief The total size of the embedded buffers, in bytes, above which they
+/// are compressed on a thread pool.
+static const size_t MinParallelCompressionSize = 1 << 20;
+
+/// \brief Compress the contents of all buffers embedded in the AST file.
+///
+/// Compression is the bulk of the work of writing the source manager block
+/// when sources are embedded, and every buffer is compressed independently,
+/// so with enough data to compress this is done on a thread pool ahead of
+/// emitting the block. The block itself is still emitted in entry order, so
+/// the output does not depend on the scheduling.
+///
+/// This is the only part of the AST file written in parallel. The other large
+/// blobs (decl, type, identifier and lookup tables) assign IDs and record
+/// offsets in the ASTWriter as they are encoded, so they are written serially.
+static void compressEmbeddedBuffers(
+    SourceManager &SourceMgr, const Preprocessor &PP,
+    std::vector<CompressedBlob> &Blobs,
+    llvm::DenseMap<const SrcMgr::ContentCache *, unsigned> &BlobIndices) {
+  if (!llvm::zlib::isAvailable())
+    return;
+
+  // Retrieve the buffers up front; the source manager is not thread-safe.
+  std::vector<StringRef> Buffers;
+  for (unsigned I = 1, N = SourceMgr.local_sloc_entry_size(); I != N; ++I) {
+    const SrcMgr::SLocEntry &SLoc = SourceMgr.getLocalSLocEntry(I);
+    if (!SLoc.isFile())
+      continue;
+    const SrcMgr::ContentCache *Content = SLoc.getFile().getContentCache();
+    if (!isEmbeddedBuffer(Content) ||
+        !BlobIndices.insert(std::make_pair(Content, Buffers.size())).second)
+      continue;
+    const llvm::MemoryBuffer *Buffer =
+        Content->getBuffer(PP.getDiagnostics(), PP.getSourceManager());
+    Buffers.push_back(
+        StringRef(Buffer->getBufferStart(), Buffer->getBufferSize() + 1));
+  }
+
+  Blobs.resize(Buffers.size());
+
+  // Starting threads costs more than compressing a few small buffers, which
+  // is the common case, e.g. for the predefines buffer alone.
+  size_t TotalSize = 0;
+  for (StringRef Buffer : Buffers)
+    TotalSize += Buffer.size();
+  if (Buffers.size() < 2 || TotalSize < MinParallelCompressionSize) {
+    for (unsigned I = 0, N = Buffers.size(); I != N; ++I)
+      compressBlob(Buffers[I], Blobs[I]);
+    return;
+  }
+
+  llvm::ThreadPool Pool(std::min<unsigned>(
+      Buffers.size(), std::max(1U, std::thread::hardware_concurrency())));
+  for (unsigned I = 0, N = Buffers.size(); I != N; ++I)
+    Pool.async([&, I] { compressBlob(Buffers[I], Blobs[I]); });
+  Pool.wait();
+}
+
 /// \brief Writes the block containing the serialized form of the
 /// source manager.
 ///
@@ -2169,6 +2259,11 @@ void ASTWriter::WriteSourceManagerBlock(SourceManager &SourceMgr,
       CreateSLocBufferBlobAbbrev(Stream, true);
   unsigned SLocExpansionAbbrv = CreateSLocExpansionAbbrev(Stream);
 
+  std::vector<CompressedBlob> CompressedBlobs;
+  llvm::DenseMap<const SrcMgr::ContentCache *, unsigned> CompressedBlobIndices;
+  compressEmbeddedBuffers(SourceMgr, PP, CompressedBlobs,
+                          CompressedBlobIndices);
+
   // Write out the source location entry table. We skip the first
   // entry, which is always the same dummy entry.
   std::vector<uint32_t> SLocEntryOffsets;
@@ -2254,8 +2349,12 @@ void ASTWriter::WriteSourceManagerBlock(SourceManager &SourceMgr,
         const llvm::MemoryBuffer *Buffer =
             Content->getBuffer(PP.getDiagnostics(), PP.getSourceManager());
         StringRef Blob(Buffer->getBufferStart(), Buffer->getBufferSize() + 1);
-        emitBlob(Stream, Blob, SLocBufferBlobCompressedAbbrv,
-                 SLocBufferBlobAbbrv);
+        auto Known = CompressedBlobIndices.find(Content);
+        emitBlob(Stream, Blob,
+                 Known != CompressedBlobIndices.end()
+                     ? &CompressedBlobs[Known->second]
+                     : nullptr,
+                 SLocBufferBlobCompressedAbbrv, SLocBufferBlobAbbrv);
       }
     } else {
       // The source location entry is a macro expansion.
@@ -3620,6 +3719,7 @@ void ASTWriter::WriteIdentifierTable(Preprocessor &PP,
     // Create the on-disk hash table representation. We only store offsets
     // for identifiers that appear here for the first time.
     IdentifierOffsets.resize(NextIdentID - FirstIdentID);
+    SmallVector<unsigned, 128> IdentifierHashes;
     for (auto IdentIDPair : IdentifierIDs) {
       auto *II = const_cast<IdentifierInfo *>(IdentIDPair.first);
       IdentID ID = IdentIDPair.second;
@@ -3629,8 +3729,10 @@ void ASTWriter::WriteIdentifierTable(Preprocessor &PP,
       if (ID >= FirstIdentID || !Chain || !II->isFromAST()
           || II->hasChangedSinceDeserialization() ||
           (Trait.needDecls() &&
-           II->hasFETokenInfoChangedSinceDeserialization()))
+           II->hasFETokenInfoChangedSinceDeserialization())) {
         Generator.insert(II, ID, Trait);
+        IdentifierHashes.push_back(ASTIdentifierTableTrait::ComputeHash(II));
+      }
     }
 
     // Create the on-disk hash table in a buffer.
@@ -3654,6 +3756,24 @@ void ASTWriter::WriteIdentifierTable(Preprocessor &PP,
     // Write the identifier table
     RecordData::value_type Record[] = {IDENTIFIER_TABLE, BucketOffset};
     Stream.EmitRecordWithBlob(IDTableAbbrev, Record, IdentifierTable);
+
+    // Write the Bloom filter over the identifiers in the table, so that
+    // lookups of identifiers not in this file do not need to probe it.
+    SmallVector<unsigned char, 512> IdentifierFilter(
+        getIdentifierFilterSize(IdentifierHashes.size()));
+    for (unsigned Hash : IdentifierHashes)
+      addToIdentifierFilter(IdentifierFilter, Hash);
+
+    Abbrev = std::make_shared<BitCodeAbbrev>();
+    Abbrev->Add(BitCodeAbbrevOp(IDENTIFIER_FILTER));
+    Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Blob));
+    unsigned IDFilterAbbrev = Stream.EmitAbbrev(std::move(Abbrev));
+
+    RecordData::value_type FilterRecord[] = {IDENTIFIER_FILTER};
+    Stream.EmitRecordWithBlob(
+        IDFilterAbbrev, FilterRecord,
+        StringRef(reinterpret_cast<const char *>(IdentifierFilter.data()),
+                  IdentifierFilter.size()));
   }
 
   // Write the offsets table for identifier IDs.
@@ -4090,6 +4210,23 @@ uint64_t ASTWriter::WriteDeclContextVisibleBlock(ASTContext &Context,
   SmallString<4096> LookupTable;
   GenerateNameLookupTable(DC, LookupTable);
 
+  // Compress large lookup tables if requested. They are only decompressed
+  // when the DeclContext is deserialized.
+  if (CompressLookupTables && LookupTable.size() >= 256 &&
+      llvm::zlib::isAvailable()) {
+    SmallString<0> CompressedTable;
+    llvm::Error E = llvm::zlib::compress(LookupTable, CompressedTable);
+    if (!E && CompressedTable.size() < LookupTable.size()) {
+      RecordData::value_type Record[] = {DECL_CONTEXT_VISIBLE_COMPRESSED,
+                                         LookupTable.size()};
+      Stream.EmitRecordWithBlob(DeclContextVisibleLookupCompressedAbbrev,
+                                Record, CompressedTable);
+      ++NumVisibleDeclContexts;
+      return Offset;
+    }
+    llvm::consumeError(std::move(E));
+  }
+
   // Write the lookup table
   RecordData::value_type Record[] = {DECL_CONTEXT_VISIBLE};
   Stream.EmitRecordWithBlob(DeclContextVisibleLookupAbbrev, Record,
@@ -4438,9 +4575,10 @@ void ASTWriter::SetSelectorOffset(Selector Sel, uint32_t Offset) {
 ASTWriter::ASTWriter(llvm::BitstreamWriter &Stream,
                      SmallVectorImpl<char> &Buffer, MemoryBufferCache &PCMCache,
                      ArrayRef<std::shared_ptr<ModuleFileExtension>> Extensions,
-                     bool IncludeTimestamps)
+                     bool IncludeTimestamps, bool CompressLookupTables)
     : Stream(Stream), Buffer(Buffer), PCMCache(PCMCache),
-      IncludeTimestamps(IncludeTimestamps) {
+      IncludeTimestamps(IncludeTimestamps),
+      CompressLookupTables(CompressLookupTables) {
   for (const auto &Ext : Extensions) {
     if (auto Writer = Ext->createExtensionWriter(*this))
       ModuleFileExtensionWriters.push_back(std::move(Writer));
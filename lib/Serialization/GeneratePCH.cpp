@@ -25,11 +25,12 @@ PCHGenerator::PCHGenerator(
     const Preprocessor &PP, StringRef OutputFile, StringRef isysroot,
     std::shared_ptr<PCHBuffer> Buffer,
     ArrayRef<std::shared_ptr<ModuleFileExtension>> Extensions,
-    bool AllowASTWithErrors, bool IncludeTimestamps)
+    bool AllowASTWithErrors, bool IncludeTimestamps,
+    bool CompressLookupTables)
     : PP(PP), OutputFile(OutputFile), isysroot(isysroot.str()),
       SemaPtr(nullptr), Buffer(std::move(Buffer)), Stream(this->Buffer->Data),
       Writer(Stream, this->Buffer->Data, PP.getPCMCache(), Extensions,
-             IncludeTimestamps),
+             IncludeTimestamps, CompressLookupTables),
       AllowASTWithErrors(AllowASTWithErrors) {
   this->Buffer->IsComplete = false;
 }
@@ -288,6 +288,14 @@ void GlobalModuleIndex::getModuleDependencies(
 }
 
 bool GlobalModuleIndex::lookupIdentifier(StringRef Name, HitSet &Hits) {
+  return lookupIdentifier(Name, IdentifierIndexReaderTrait::ComputeHash(Name),
+                          Hits);
+}
+
+bool GlobalModuleIndex::lookupIdentifier(StringRef Name, unsigned NameHash,
+                                         HitSet &Hits) {
+  assert(NameHash == IdentifierIndexReaderTrait::ComputeHash(Name) &&
+         "Wrong identifier hash!");
   Hits.clear();
   
   // If there's no identifier index, there is nothing we can do.
@@ -298,7 +306,7 @@ bool GlobalModuleIndex::lookupIdentifier(StringRef Name, HitSet &Hits) {
   ++NumIdentifierLookups;
   IdentifierIndexTable &Table
     = *static_cast<IdentifierIndexTable *>(IdentifierIndex);
-  IdentifierIndexTable::iterator Known = Table.find(Name);
+  IdentifierIndexTable::iterator Known = Table.find_hashed(Name, NameHash);
   if (Known == Table.end()) {
     return true;
   }
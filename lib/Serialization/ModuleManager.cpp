@@ -151,9 +151,12 @@ ModuleManager::addModule(StringRef FileName, ModuleKind Type,
       // ModuleManager it must be the same underlying file.
       // FIXME: Because FileManager::getFile() doesn't guarantee that it will
       // give us an open file, this may not be 100% reliable.
-      Buf = FileMgr.getBufferForFile(NewModule->File,
-                                     /*IsVolatile=*/false,
-                                     /*ShouldClose=*/false);
+      // The bitstream reader does not need a null terminator. Without it,
+      // module files whose size is a multiple of the page size are mapped
+      // like other large files instead of being read into memory.
+      Buf = FileMgr.getBufferForFile(
+          NewModule->File, /*IsVolatile=*/false, /*ShouldClose=*/false,
+          /*RequiresNullTerminator=*/false);
     }
 
     if (!Buf) {
@@ -386,6 +386,24 @@ int ClangTool::run(ToolAction *Action) {
             MappedFile.first, 0,
             llvm::MemoryBuffer::getMemBuffer(MappedFile.second));
 
+  // A single consumer shared by all the translation units drops the
+  // diagnostics any of them already reported.
+  DiagnosticConsumer *Consumer = DiagConsumer;
+  std::unique_ptr<DiagnosticConsumer> DefaultPrinter;
+  std::unique_ptr<DeduplicatingDiagnosticConsumer> Deduplicator;
+  if (DeduplicateDiagnostics) {
+    if (!ReportedDiagnostics)
+      ReportedDiagnostics = new DiagnosticDeduplicationSet();
+    if (!Consumer) {
+      DefaultPrinter = llvm::make_unique<TextDiagnosticPrinter>(
+          llvm::errs(), new DiagnosticOptions());
+      Consumer = DefaultPrinter.get();
+    }
+    Deduplicator = llvm::make_unique<DeduplicatingDiagnosticConsumer>(
+        Consumer, ReportedDiagnostics);
+    Consumer = Deduplicator.get();
+  }
+
   bool ProcessingFailed = false;
   for (const auto &SourcePath : SourcePaths) {
     std::string File(getAbsolutePath(SourcePath));
@@ -451,7 +469,7 @@ int ClangTool::run(ToolAction *Action) {
       DEBUG({ llvm::dbgs() << "Processing: " << File << ".\n"; });
       ToolInvocation Invocation(std::move(CommandLine), Action, Files.get(),
                                 PCHContainerOps);
-      Invocation.setDiagnosticConsumer(DiagConsumer);
+      Invocation.setDiagnosticConsumer(Consumer);
 
       if (!Invocation.run()) {
         // FIXME: Diagnostics should be used instead.
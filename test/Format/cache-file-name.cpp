@@ -0,0 +1,20 @@
+// RUN: rm -rf %t.dir
+// RUN: mkdir -p %t.dir
+// RUN: grep '^#include' %s > %t.dir/z.cpp
+// RUN: cp %t.dir/z.cpp %t.dir/other.cpp
+// RUN: clang-format -style=LLVM -i -cache-file=%t.dir/cache %t.dir/z.cpp
+// RUN: clang-format -style=LLVM -i -cache-file=%t.dir/cache %t.dir/other.cpp
+// RUN: FileCheck -check-prefix=MAIN -input-file=%t.dir/z.cpp %s
+// RUN: FileCheck -check-prefix=SORTED -input-file=%t.dir/other.cpp %s
+
+#include "z.h"
+#include "a.h"
+
+// In z.cpp, z.h is the main header and stays first.
+// MAIN: {{^#include "z.h"$}}
+// MAIN-NEXT: {{^#include "a.h"$}}
+
+// The same contents are sorted in other.cpp, even though they were recorded
+// as formatted for z.cpp.
+// SORTED: {{^#include "a.h"$}}
+// SORTED-NEXT: {{^#include "z.h"$}}
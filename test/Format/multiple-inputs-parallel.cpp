@@ -0,0 +1,21 @@
+// RUN: rm -f %t.cache
+// RUN: cp %s %t-1.cpp
+// RUN: cp %s %t-2.cpp
+// RUN: cp %s %t-3.cpp
+// RUN: clang-format -style=LLVM -i -j 2 -cache-file=%t.cache %t-1.cpp %t-2.cpp %t-3.cpp
+// RUN: FileCheck -strict-whitespace -input-file=%t-1.cpp %s
+// RUN: FileCheck -strict-whitespace -input-file=%t-2.cpp %s
+// RUN: FileCheck -strict-whitespace -input-file=%t-3.cpp %s
+// RUN: FileCheck -check-prefix=CACHE -input-file=%t.cache %s
+// RUN: clang-format -style=LLVM -i -j 2 -cache-file=%t.cache %t-1.cpp %t-2.cpp %t-3.cpp
+// RUN: FileCheck -strict-whitespace -input-file=%t-1.cpp %s
+
+// CHECK: {{^int\ \*i;}}
+ int   *  i  ;
+
+// The file name is part of each entry, so the three files get one entry
+// each even though they end up with the same contents.
+// CACHE: {{^[0-9a-f]+$}}
+// CACHE-NEXT: {{^[0-9a-f]+$}}
+// CACHE-NEXT: {{^[0-9a-f]+$}}
+// CACHE-NOT: {{.}}
@@ -0,0 +1 @@
+void store_header_func(void);
@@ -0,0 +1,24 @@
+// RUN: rm -rf %t.idx %t.inputs && mkdir -p %t.inputs
+// RUN: cp %S/Inputs/store/store-header.h %t.inputs/store-header.h
+// RUN: c-index-test core -index-to-store -store-path %t.idx -- %s -I %t.inputs | count 0
+// RUN: c-index-test core -print-store-occurrences -store-path %t.idx -usr c:@F@store_header_func | FileCheck %s
+
+// Indexing again without changes reuses the unit without parsing.
+// RUN: c-index-test core -index-to-store -store-path %t.idx -- %s -I %t.inputs | FileCheck -check-prefix=REUSED %s
+
+// Changing a dependency makes the translation unit be indexed again.
+// RUN: echo 'void store_header_func2(void);' >> %t.inputs/store-header.h
+// RUN: c-index-test core -index-to-store -store-path %t.idx -- %s -I %t.inputs | count 0
+// RUN: c-index-test core -print-store-occurrences -store-path %t.idx -usr c:@F@store_header_func2 | FileCheck -check-prefix=CHECK-NEW %s
+
+// The header has no include guard, so it is included twice, but each of its
+// occurrences is recorded once.
+#include "store-header.h"
+#include "store-header.h"
+
+// REUSED: unit is up-to-date: {{.*}}index-store-reuse.c
+
+// CHECK: store-header.h:1:6 | function | Decl
+// CHECK-NOT: store-header.h:1:6
+
+// CHECK-NEW: store-header.h:2:6 | function | Decl
@@ -0,0 +1,19 @@
+// RUN: rm -rf %t.idx
+// RUN: c-index-test core -index-to-store -store-path %t.idx -- %s -I %S/Inputs/store
+// RUN: c-index-test core -print-store-occurrences -store-path %t.idx -usr c:@F@store_header_func | FileCheck %s
+// Reindexing an unchanged translation unit reuses the existing unit.
+// RUN: c-index-test core -index-to-store -store-path %t.idx -- %s -I %S/Inputs/store
+// RUN: c-index-test core -print-store-occurrences -store-path %t.idx -usr c:@F@store_header_func | FileCheck %s
+// RUN: c-index-test core -print-store-occurrences -store-path %t.idx -usr c:@F@test1 | FileCheck -check-prefix=CHECK-TEST1 %s
+
+#include "store-header.h"
+
+// CHECK: unit: index-store.c-{{[0-9a-f]+}}
+// CHECK-DAG: dep: {{.*}}index-store.c
+// CHECK-DAG: dep: {{.*}}store-header.h
+// CHECK-DAG: {{.*}}store-header.h:1:6 | function | Decl
+// CHECK-TEST1: {{.*}}index-store.c:[[@LINE+1]]:6 | function | Def
+void test1(void) {
+  // CHECK-DAG: {{.*}}index-store.c:[[@LINE+1]]:3 | function | Ref,Call,RelCall,RelCont
+  store_header_func();
+}
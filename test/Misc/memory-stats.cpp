@@ -0,0 +1,50 @@
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
+// RUN: rm -f %t.json
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -memory-stats-file=%t.json %s
+// RUN: FileCheck -check-prefix=JSON %s < %t.json
+//
+// Each input gets its own entry, with its own counts of each kind.
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -memory-stats-file=%t.json %s %s
+// RUN: FileCheck -check-prefix=JSON2 %s < %t.json
+
+// CHECK: *** AST Context Memory Breakdown:
+// CHECK-NEXT: {{[1-9][0-9]*}} bytes in declarations
+// CHECK-NEXT: {{[1-9][0-9]*}} bytes in types
+// CHECK-NEXT: {{[1-9][0-9]*}} bytes in statements and expressions
+// CHECK-NEXT: {{[1-9][0-9]*}} bytes in template argument lists
+// CHECK-NEXT: {{[1-9][0-9]*}} bytes in attributes
+// CHECK-NEXT: {{[0-9]+}} bytes in other AST data
+// CHECK-NEXT: {{[1-9][0-9]*}} bytes allocated in the AST arena
+// CHECK-NEXT: {{[1-9][0-9]*}} bytes in declaration context lookup tables
+// CHECK-NEXT: {{[1-9][0-9]*}} bytes in side tables
+
+// JSON: [
+// JSON-NEXT: {
+// JSON-NEXT: "file": "{{.*}}memory-stats.cpp",
+// JSON-NEXT: "ast": {"decls": {{[1-9][0-9]*}}, "types": {{[1-9][0-9]*}}, "stmts": {{[1-9][0-9]*}}, "template_argument_lists": {{[1-9][0-9]*}}, "attrs": {{[1-9][0-9]*}}, "other": {{[0-9]+}}, "arena": {{[1-9][0-9]*}}, "lookup_tables": {{[1-9][0-9]*}}, "side_tables": {{[1-9][0-9]*}}},
+// JSON-NEXT: "decls_by_kind": {{[{].*}}"Namespace": {"count": {{[1-9][0-9]*}}, "bytes": {{[1-9][0-9]*}}}{{.*}}},
+// JSON-NEXT: "types_by_kind": {{[{].*}}"TemplateSpecialization": {"count": {{[1-9][0-9]*}}, "bytes": {{[1-9][0-9]*}}}{{.*}}},
+// JSON-NEXT: "stmts_by_kind": {{[{].*}}"ReturnStmt": {"count": {{[1-9][0-9]*}}, "bytes": {{[1-9][0-9]*}}}{{.*}}},
+// JSON-NEXT: "sema_arena": {{[0-9]+}}
+// JSON-NEXT: }
+// JSON-NEXT: ]
+
+// JSON2: [
+// JSON2-NEXT: {
+// JSON2-NEXT: "file": "{{.*}}memory-stats.cpp",
+// JSON2: "decls_by_kind": {{[{].*}}"Function": {"count": [[FUNCTIONS:[0-9]+]],
+// JSON2: {{^}}},
+// JSON2-NEXT: {
+// JSON2-NEXT: "file": "{{.*}}memory-stats.cpp",
+// JSON2: "decls_by_kind": {{[{].*}}"Function": {"count": [[FUNCTIONS]],
+// JSON2: {{^}}}{{$}}
+// JSON2-NEXT: ]
+
+namespace N {
+template<typename T> struct S { T get() const { return T(); } };
+}
+
+int f() {
+  N::S<int> s __attribute__((aligned(16)));
+  return s.get();
+}
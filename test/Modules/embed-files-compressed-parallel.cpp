@@ -0,0 +1,52 @@
+// REQUIRES: zlib
+// REQUIRES: shell
+//
+// RUN: rm -rf %t
+// RUN: mkdir %t
+// RUN: echo '//////////////////////////////////////////////////////////////////////' > %t/a.h
+// RUN: cat %t/a.h %t/a.h %t/a.h %t/a.h > %t/b.h
+// RUN: cat %t/b.h %t/b.h %t/b.h %t/b.h > %t/a.h
+// RUN: cat %t/a.h %t/a.h %t/a.h %t/a.h > %t/b.h
+// RUN: cat %t/b.h %t/b.h %t/b.h %t/b.h > %t/a.h
+// RUN: cat %t/a.h %t/a.h %t/a.h %t/a.h > %t/b.h
+// RUN: cat %t/b.h %t/b.h %t/b.h %t/b.h > %t/a.h
+// RUN: echo 'int x;' > %t/x.h
+// RUN: echo 'int yy;' > %t/y.h
+// RUN: echo 'int zzz;' > %t/z.h
+// RUN: echo 'int wwww;' > %t/w.h
+// RUN: cat %t/a.h >> %t/x.h
+// RUN: cat %t/a.h >> %t/y.h
+// RUN: cat %t/a.h >> %t/z.h
+// RUN: cat %t/a.h >> %t/w.h
+// RUN: echo 'module small { header "x.h" header "y.h" }' > %t/small.modulemap
+// RUN: echo 'module big { header "x.h" header "y.h" header "z.h" header "w.h" }' > %t/big.modulemap
+//
+// Each header embeds 284KB. The two headers of 'small' are compressed one
+// after the other, the four headers of 'big' on a thread pool.
+// RUN: %clang_cc1 -fmodules -I%t -fmodules-cache-path=%t -fmodule-name=small -emit-module %t/small.modulemap -fmodules-embed-all-files -o %t/small.pcm
+// RUN: %clang_cc1 -fmodules -I%t -fmodules-cache-path=%t -fmodule-name=big -emit-module %t/big.modulemap -fmodules-embed-all-files -o %t/big.pcm
+// RUN: %clang_cc1 -fmodules -I%t -fmodules-cache-path=%t -fmodule-name=big -emit-module %t/big.modulemap -fmodules-embed-all-files -o %t/big-check.pcm
+//
+// The output does not depend on the scheduling of the compression.
+// RUN: diff %t/big.pcm %t/big-check.pcm
+//
+// x.h (290823 bytes) is compressed to the same blob either way.
+// RUN: llvm-bcanalyzer -dump %t/small.pcm | grep 'SM_SLOC_BUFFER_BLOB_COMPRESSED.*op0=290823/>' > %t/x-serial
+// RUN: llvm-bcanalyzer -dump %t/big.pcm | grep 'SM_SLOC_BUFFER_BLOB_COMPRESSED.*op0=290823/>' > %t/x-parallel
+// RUN: cat %t/x-parallel | count 1
+// RUN: diff %t/x-serial %t/x-parallel
+//
+// The compressed headers are read back from the module file.
+// RUN: rm %t/x.h %t/w.h
+// RUN: not %clang_cc1 -fmodules -I%t -fmodule-map-file=%t/big.modulemap -fmodule-file=%t/big.pcm %s 2>&1 | FileCheck %s
+#include "y.h"
+
+char x;
+// CHECK: error: redefinition of 'x' with a different type
+// CHECK: x.h:1:5: note: previous definition is here
+// CHECK-NEXT: int x;
+
+char wwww;
+// CHECK: error: redefinition of 'wwww' with a different type
+// CHECK: w.h:1:5: note: previous definition is here
+// CHECK-NEXT: int wwww;
@@ -0,0 +1,28 @@
+#include "foo.h"
+
+// RUN: rm -rf %t
+// RUN: mkdir -p %t/Inputs
+// RUN: echo 'void meow(void);' > %t/Inputs/foo.h
+// RUN: echo 'module Foo { header "foo.h" }' > %t/Inputs/module.map
+
+// Build the module, then load it from the module cache, which opens the
+// module file without a null terminator.
+// RUN: %clang_cc1 -fmodules -fimplicit-module-maps -fdisable-module-hash -fmodules-cache-path=%t/modules-cache -fsyntax-only -I %t/Inputs %s
+// RUN: cp %t/modules-cache/Foo.pcm %t/Foo-before.pcm
+// RUN: %clang_cc1 -fmodules -fimplicit-module-maps -fdisable-module-hash -fmodules-cache-path=%t/modules-cache -fsyntax-only -I %t/Inputs -verify -DUSE_MEOW %s
+// RUN: diff %t/Foo-before.pcm %t/modules-cache/Foo.pcm
+
+// Input files are still validated, so a changed header rebuilds the module.
+// RUN: echo 'void meow2(void);' > %t/Inputs/foo.h
+// RUN: %clang_cc1 -fmodules -fimplicit-module-maps -fdisable-module-hash -fmodules-cache-path=%t/modules-cache -fsyntax-only -I %t/Inputs -verify -DUSE_MEOW2 %s
+// RUN: not diff %t/Foo-before.pcm %t/modules-cache/Foo.pcm
+
+#if defined(USE_MEOW) || defined(USE_MEOW2)
+// expected-no-diagnostics
+#endif
+#ifdef USE_MEOW
+void purr(void) { meow(); }
+#endif
+#ifdef USE_MEOW2
+void purr(void) { meow2(); }
+#endif
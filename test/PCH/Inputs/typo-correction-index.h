@@ -0,0 +1,2 @@
+int pch_counter_value;
+int pch_unrelated_name;
@@ -0,0 +1,32 @@
+// REQUIRES: zlib
+// RUN: %clang_cc1 -x c++-header -emit-pch -fcompress-ast-lookup-tables -o %t %s
+// RUN: %clang_cc1 -include-pch %t -fsyntax-only -verify -print-stats %s 2>&1 \
+// RUN:   | FileCheck %s
+//
+// Without the flag, lookup tables are stored uncompressed.
+// RUN: %clang_cc1 -x c++-header -emit-pch -o %t.plain %s
+// RUN: %clang_cc1 -include-pch %t.plain -fsyntax-only -verify -print-stats %s \
+// RUN:   2>&1 | FileCheck -check-prefix=CHECK-PLAIN %s
+
+// CHECK: {{[0-9]+}} lookup tables decompressed
+// CHECK-PLAIN-NOT: lookup tables decompressed
+
+#ifndef HEADER
+#define HEADER
+
+#define DECLARE4(N) int N##0(); int N##1(); int N##2(); int N##3();
+#define DECLARE16(N) DECLARE4(N##0) DECLARE4(N##1) DECLARE4(N##2) \
+                     DECLARE4(N##3)
+
+namespace ns {
+DECLARE16(function)
+DECLARE16(variable)
+struct Record { int Member; };
+}
+
+#else
+
+// expected-no-diagnostics
+int use() { return ns::function00() + ns::variable33() + ns::Record().Member; }
+
+#endif
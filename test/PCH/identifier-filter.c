@@ -0,0 +1,27 @@
+// RUN: %clang_cc1 -emit-pch -o %t %s
+// RUN: llvm-bcanalyzer -dump %t | FileCheck -check-prefix=CHECK-BITCODE %s
+// RUN: %clang_cc1 -include-pch %t -fsyntax-only -verify -print-stats %s 2>&1 \
+// RUN:   | FileCheck %s
+
+// CHECK-BITCODE: <IDENTIFIER_TABLE
+// CHECK-BITCODE: <IDENTIFIER_FILTER
+
+// Identifiers that are not in the PCH are rejected without probing its
+// identifier table.
+// CHECK: {{[0-9]+}} / {{[0-9]+}} identifier table lookups rejected by identifier filters
+
+#ifndef HEADER
+#define HEADER
+
+int from_header(int value);
+struct header_record { int field; };
+
+#else
+
+// expected-no-diagnostics
+int only_in_main_file(int first_parameter, int second_parameter) {
+  struct header_record local_record = { first_parameter };
+  return from_header(local_record.field + second_parameter);
+}
+
+#endif
@@ -0,0 +1,31 @@
+// REQUIRES: shell
+// RUN: rm -rf %t && mkdir -p %t
+// RUN: for i in $(seq 1 40); do \
+// RUN:   echo "int f$i(void);" > %t/h$i.h; \
+// RUN:   echo "#include \"h$i.h\"" >> %t/all.h; \
+// RUN: done
+// RUN: %clang_cc1 -x c-header -emit-pch -o %t/all.pch %t/all.h
+//
+// The headers of the PCH are unknown to the file manager when it is loaded,
+// so they are stat'ed in a parallel batch before being validated.
+// RUN: %clang_cc1 -include-pch %t/all.pch -fsyntax-only -verify -print-stats \
+// RUN:   %s 2>&1 | FileCheck %s
+// CHECK: {{[0-9]+}} input files validated ({{[1-9][0-9]*}} stat'ed in parallel)
+//
+// A PCH whose headers have changed is still rejected.
+// RUN: echo "int f1(int);" > %t/h1.h
+// RUN: not %clang_cc1 -include-pch %t/all.pch -fsyntax-only %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=CHECK-CHANGED %s
+// CHECK-CHANGED: file '{{.*}}h1.h' has been modified since the precompiled header
+// RUN: echo "int f1(void);" > %t/h1.h
+// RUN: %clang_cc1 -x c-header -emit-pch -o %t/all.pch %t/all.h
+//
+// Files seen through a VFS overlay are not stat'ed in parallel.
+// RUN: echo "{ 'version': 0, 'roots': [] }" > %t/empty.yaml
+// RUN: %clang_cc1 -include-pch %t/all.pch -ivfsoverlay %t/empty.yaml \
+// RUN:   -fsyntax-only -verify -print-stats %s 2>&1 \
+// RUN:   | FileCheck -check-prefix=CHECK-VFS %s
+// CHECK-VFS: {{[0-9]+}} input files validated (0 stat'ed in parallel)
+
+// expected-no-diagnostics
+int use(void) { return f1() + f40(); }
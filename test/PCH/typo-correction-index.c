@@ -0,0 +1,25 @@
+// RUN: %clang_cc1 -emit-pch -o %t %S/Inputs/typo-correction-index.h
+// RUN: %clang_cc1 -include-pch %t -fsyntax-only -verify -print-stats %s 2>&1 \
+// RUN:   | FileCheck %s
+
+// CHECK: 3 typo corrections attempted.
+// CHECK: {{[0-9]+}} local and {{[0-9]+}} external identifiers indexed for typo correction.
+// CHECK: 3 typo correction candidate searches; {{[0-9]+}} identifiers of similar length, {{[0-9]+}} rejected by character signature.
+// CHECK: seconds searching for typo correction candidates.
+
+int local_counter;
+
+int test() {
+  int a = local_countr; // expected-error{{use of undeclared identifier 'local_countr'; did you mean 'local_counter'?}}
+  // expected-note@-4{{'local_counter' declared here}}
+  return pch_counter_vaule; // expected-error{{use of undeclared identifier 'pch_counter_vaule'; did you mean 'pch_counter_value'?}}
+  // expected-note@Inputs/typo-correction-index.h:1{{'pch_counter_value' declared here}}
+}
+
+// Identifiers added after the index was built are indexed by the next search.
+int late_declared_total;
+
+int test_late() {
+  return late_declared_totl; // expected-error{{use of undeclared identifier 'late_declared_totl'; did you mean 'late_declared_total'?}}
+  // expected-note@-4{{'late_declared_total' declared here}}
+}
@@ -0,0 +1,70 @@
+// RUN: %clang_cc1 -std=c++14 -parse-declarations-only -verify %s
+// RUN: %clang_cc1 -std=c++14 -parse-declarations-only -fdelayed-template-parsing -verify %s
+// RUN: %clang_cc1 -std=c++14 -fsyntax-only -verify -DFULL %s
+// RUN: env CINDEXTEST_PARSE_DECLARATIONS_ONLY=1 c-index-test -test-load-source all -std=c++14 %s | FileCheck %s
+
+void f() {
+  undeclared();
+#ifdef FULL
+  // expected-error@-2 {{use of undeclared identifier 'undeclared'}}
+#endif
+}
+
+template <typename T> struct Box {
+  T get() const { return undeclared_in_template; }
+#ifdef FULL
+  // expected-error@-2 {{use of undeclared identifier 'undeclared_in_template'}}
+#endif
+  void set(T) {
+    struct Local {};
+  }
+};
+
+// Bodies that the declarations depend on are still parsed.
+constexpr int square(int N) { return N * N; }
+static_assert(square(3) == 9, "");
+
+auto deduced() { return 1L; }
+decltype(deduced()) L = 0;
+static_assert(sizeof(L) == sizeof(long), "");
+
+// Constant evaluation that is not needed by the declarations is skipped.
+int nonConstexpr();
+#ifdef FULL
+// expected-note@-2 2 {{declared here}}
+#endif
+
+constexpr int neverConstant() { return nonConstexpr(); }
+#ifdef FULL
+// expected-error@-2 {{constexpr function never produces a constant expression}}
+// expected-note@-3 {{non-constexpr function 'nonConstexpr' cannot be used in a constant expression}}
+#endif
+
+constexpr int NotConstant = nonConstexpr();
+#ifdef FULL
+// expected-error@-2 {{constexpr variable 'NotConstant' must be initialized by a constant expression}}
+// expected-note@-3 {{non-constexpr function 'nonConstexpr' cannot be used in a constant expression}}
+#endif
+
+// Definitions that are not instantiated or synthesized in this mode are not
+// reported as used but undefined.
+template <typename T> struct Used {
+  int get() { return 0; }
+};
+int UsedValue = Used<int>().get();
+
+struct NonTrivial {
+  NonTrivial() {}
+};
+struct HasNonTrivial {
+  NonTrivial Member;
+};
+HasNonTrivial Global;
+
+// CHECK: FunctionDecl=f:6:6
+// CHECK: ClassTemplate=Box:13:30 (Definition)
+// CHECK: CXXMethod=get:14:5
+// CHECK: CXXMethod=set:18:8
+// CHECK-NOT: StructDecl=Local
+// CHECK: FunctionDecl=square:24:15 (Definition)
+// CHECK: VarDecl=NotConstant:43:15
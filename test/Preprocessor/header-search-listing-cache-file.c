@@ -0,0 +1,30 @@
+// REQUIRES: shell
+// RUN: rm -rf %t && mkdir -p %t/listed %t/fallback
+// RUN: echo 'int from_fallback;' > %t/fallback/late.h
+// RUN: touch -m -t 201101010000 %t/listed
+
+// The listing of %t/listed is saved to the cache file.
+// RUN: %clang_cc1 -fheader-search-listing-cache-path=%t.listings -I %t/listed -I %t/fallback -E %s -o - | FileCheck -check-prefix=FALLBACK %s
+
+// Adding a header and then restoring the modification time of the directory
+// hides the header from a listing loaded from the cache file, which shows
+// that the file was used instead of the directory.
+// RUN: echo 'int from_listed;' > %t/listed/late.h
+// RUN: touch -m -t 201101010000 %t/listed
+// RUN: %clang_cc1 -fheader-search-listing-cache-path=%t.listings -I %t/listed -I %t/fallback -E %s -o - | FileCheck -check-prefix=FALLBACK %s
+// RUN: %clang_cc1 -fheader-search-listing-cache-path=%t.listings -I %t/listed -I %t/fallback -fsyntax-only -print-stats %s 2>&1 | FileCheck -check-prefix=STATS %s
+
+// A directory modified no earlier than it is read, here because its
+// modification time is in the future, is not saved.
+// RUN: rm -rf %t.listings %t/listed/late.h
+// RUN: touch -m -t 203701010000 %t/listed
+// RUN: %clang_cc1 -fheader-search-listing-cache-path=%t.listings -I %t/listed -I %t/fallback -E %s -o - | FileCheck -check-prefix=FALLBACK %s
+// RUN: echo 'int from_listed;' > %t/listed/late.h
+// RUN: touch -m -t 203701010000 %t/listed
+// RUN: %clang_cc1 -fheader-search-listing-cache-path=%t.listings -I %t/listed -I %t/fallback -E %s -o - | FileCheck -check-prefix=LISTED %s
+
+#include "late.h"
+
+// FALLBACK: int from_fallback;
+// LISTED: int from_listed;
+// STATS: 1 lookups rejected by directory listings.
@@ -0,0 +1,16 @@
+// RUN: rm -f %t.listings
+// RUN: %clang_cc1 -fheader-search-listing-cache-path=%t.listings -F %S/Inputs/listing-cache/a -F %S/Inputs/listing-cache/frameworks -fsyntax-only -print-stats %s 2>&1 | FileCheck -check-prefix=STATS %s
+// RUN: test -f %t.listings
+// RUN: %clang_cc1 -fheader-search-listing-cache-path=%t.listings -F %S/Inputs/listing-cache/a -F %S/Inputs/listing-cache/frameworks -fsyntax-only -print-stats %s 2>&1 | FileCheck -check-prefix=STATS %s
+// RUN: %clang -### -fheader-search-listing-cache-path=%t.listings -c %s 2>&1 | FileCheck -check-prefix=DRIVER %s
+
+#include <Listed/Listed.h>
+
+int *p = &listed;
+
+// The framework directory a has no Listed.framework, and Listed.framework
+// has no .system_framework marker; both are answered from listings, the
+// second time from the saved cache file.
+// STATS: 2 lookups rejected by directory listings.
+
+// DRIVER: "-fheader-search-listing-cache-path={{.*}}.listings"
@@ -0,0 +1,18 @@
+// RUN: %clang_cc1 -fheader-search-listing-cache -I %S/Inputs/listing-cache/a -I %S/Inputs/listing-cache/b -E %s | FileCheck %s
+// RUN: %clang_cc1 -fheader-search-listing-cache -I %S/Inputs/listing-cache/a -I %S/Inputs/listing-cache/b -fsyntax-only -print-stats %s 2>&1 | FileCheck -check-prefix=STATS %s
+// RUN: %clang_cc1 -fheader-search-listing-cache -working-directory %S/Inputs/listing-cache -I a -I b -fsyntax-only -print-stats %s 2>&1 | FileCheck -check-prefix=STATS %s
+// RUN: %clang -### -fheader-search-listing-cache -c %s 2>&1 | FileCheck -check-prefix=DRIVER %s
+
+#include "in-a.h"
+#include "in-b.h"
+#include "sub/in-sub.h"
+
+// CHECK: int in_a;
+// CHECK: int in_b;
+// CHECK: int in_b_sub;
+
+// Looking up in-b.h and sub/in-sub.h in directory a is answered from the
+// listing of a.
+// STATS: 2 lookups rejected by directory listings.
+
+// DRIVER: "-fheader-search-listing-cache"
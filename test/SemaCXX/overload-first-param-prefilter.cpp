@@ -0,0 +1,25 @@
+// RUN: %clang_cc1 -fsyntax-only -verify -print-stats %s 2>&1 | FileCheck %s
+
+// CHECK: {{[0-9]+}} overload resolutions, {{[0-9]+}} candidates considered, {{[0-9]+}} viable.
+// CHECK: 7 overload candidates rejected by first parameter type.
+
+struct Stream {};
+struct DerivedStream : Stream {};
+struct OtherStream {};
+struct Convertible { operator OtherStream &(); };
+
+struct Value {};
+
+Stream &operator<<(Stream &, Value); // expected-note{{candidate function not viable: no known conversion from 'int' to 'Stream &' for 1st argument}}
+OtherStream &operator<<(OtherStream &, Value); // expected-note{{candidate function not viable: no known conversion from 'int' to 'OtherStream &' for 1st argument}}
+OtherStream &operator<<(OtherStream &, int); // expected-note{{candidate function not viable: no known conversion from 'int' to 'OtherStream &' for 1st argument}}
+
+// Stream and OtherStream candidates are rejected without computing a
+// conversion sequence for the first argument unless it is derived from the
+// parameter's class or has conversion functions.
+void test(Stream &S, DerivedStream &D, Convertible &C, Value V) {
+  S << V;
+  D << V;
+  C << V;
+  1 << V; // expected-error{{invalid operands to binary expression ('int' and 'Value')}}
+}
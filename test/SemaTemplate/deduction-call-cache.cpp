@@ -0,0 +1,37 @@
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -verify -print-stats %s 2>&1 \
+// RUN:   | FileCheck %s
+
+// CHECK: 7 function template call deductions cached, 2 reused.
+
+template<typename T, typename U> struct is_same { static const bool value = false; };
+template<typename T> struct is_same<T, T> { static const bool value = true; };
+
+// Repeated deductions with the same argument types reuse the cached
+// specialization.
+template<typename T> T identity(T t) { return t; }
+
+void test_identity(int i, long l) {
+  identity(i);
+  identity(i + 1);
+  identity(l);
+  identity(2L);
+  static_assert(is_same<decltype(identity(i)), int>::value, "");
+}
+
+// Forwarding references deduce differently for lvalues and rvalues.
+template<typename T> T &&forward_ref(T &&t);
+
+void test_forward_ref(int i) {
+  static_assert(is_same<decltype(forward_ref(i)), int &>::value, "");
+  static_assert(is_same<decltype(forward_ref(static_cast<int &&>(i))),
+                        int &&>::value, "");
+}
+
+// Conversions to non-dependent parameters are checked for each call, since
+// they depend on the argument expression rather than its type.
+template<typename T> void non_dependent(T t, int *p); // expected-note{{candidate}}
+
+void test_non_dependent(int i) {
+  non_dependent(i, 0);
+  non_dependent(i, i - i); // expected-error{{no matching function for call to 'non_dependent'}}
+}
@@ -0,0 +1,17 @@
+// RUN: %clang_cc1 -triple i686-windows-msvc -std=c++11 -fms-extensions -fsyntax-only -flazy-template-member-instantiation -verify -print-stats %s 2>&1 \
+// RUN:   | FileCheck %s
+// expected-no-diagnostics
+
+// All the members of a dllexported class are emitted, so none of them are
+// deferred.
+// CHECK: 1 member declarations deferred, 0 later instantiated.
+
+template<typename T> struct __declspec(dllexport) Exported {
+  int get() { return 0; }
+};
+template<typename T> struct Plain {
+  int get() { return 0; }
+};
+
+Exported<int> E;
+Plain<int> P;
@@ -0,0 +1,69 @@
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -verify %s
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -flazy-template-member-instantiation -verify -print-stats %s 2>&1 \
+// RUN:   | FileCheck %s
+// expected-no-diagnostics
+
+// CHECK: 17 member declarations deferred, 12 later instantiated.
+
+template<typename T> struct Box {
+  Box() : Value() {}
+  T get() const { return Value; }
+  void set(T V) { Value = V; }
+  void set(T V, int) { Value = V; }
+  template<typename U> U as() const { return U(Value); }
+  bool operator==(const Box &Other) const { return Value == Other.Value; }
+
+  T Value;
+};
+
+// Member function calls.
+int testCall() {
+  Box<int> B;
+  B.set(1);
+  B.set(2, 3);
+  return B.get() + B.as<int>();
+}
+
+// Qualified lookup.
+void (Box<short>::*SetShort)(short) = &Box<short>::set;
+
+// Lookup into a base class.
+struct Derived : Box<float> {};
+int testBase(Derived &D) { return D.as<int>(); }
+
+// Explicit instantiation instantiates every pending member.
+Box<long> *LongBox;
+long testLong() { return LongBox->Value; }
+template struct Box<long>;
+
+// Members of classes with a polymorphic base may override a virtual function,
+// so they are never deferred.
+struct PolyBase { virtual int get() const; };
+template<typename T> struct Poly : PolyBase {
+  int get() const { return 0; }
+};
+int testPoly(Poly<int> &P) { return P.get(); }
+
+// A name is only deferred if all of its members can be: an eagerly
+// instantiated overload would otherwise hide the deferred ones from lookup.
+template<typename T> struct MixedVirtual {
+  virtual int f(int) { return 1; }
+  int f() { return 0; }
+};
+int testMixedVirtual(MixedVirtual<int> &M) { return M.f() + M.f(1); }
+
+template<typename T> struct MixedAttributed {
+  __attribute__((noinline)) int g(int) { return 1; }
+  int g() { return 0; }
+  int h() { return 2; }
+};
+int testMixedAttributed(MixedAttributed<int> &M) {
+  return M.g() + M.g(1) + M.h();
+}
+
+struct UsingBase { int k(int) { return 1; } };
+template<typename T> struct MixedUsing : UsingBase {
+  using UsingBase::k;
+  int k() { return 0; }
+};
+int testMixedUsing(MixedUsing<int> &M) { return M.k() + M.k(1); }
@@ -0,0 +1,13 @@
+// RUN: rm -rf %t
+// RUN: mkdir %t
+// RUN: echo '#warning "in shared header"' > %t/shared.h
+// RUN: echo '#include "shared.h"' > %t/a.cpp
+// RUN: echo '#include "shared.h"' > %t/b.cpp
+// RUN: clang-check %t/a.cpp %t/b.cpp -- -I%t 2>&1 | FileCheck -check-prefix=ALL %s
+// RUN: clang-check -deduplicate-diagnostics %t/a.cpp %t/b.cpp -- -I%t 2>&1 | FileCheck -check-prefix=DEDUP %s
+
+// ALL: shared.h:1:2: warning: "in shared header"
+// ALL: shared.h:1:2: warning: "in shared header"
+
+// DEDUP: shared.h:1:2: warning: "in shared header"
+// DEDUP-NOT: warning: "in shared header"
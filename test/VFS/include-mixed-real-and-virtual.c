@@ -3,6 +3,7 @@
 // RUN: echo "void baz(void);" > %t/real.h
 // RUN: sed -e "s:INPUT_DIR:%S/Inputs:g" -e "s:OUT_DIR:%t:g" %S/Inputs/vfsoverlay.yaml > %t.yaml
 // RUN: %clang_cc1 -Werror -ivfsoverlay %t.yaml -I %t -fsyntax-only %s
+// RUN: %clang_cc1 -Werror -ivfsoverlay %t.yaml -I %t -fheader-search-listing-cache -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
 // REQUIRES: shell
 
 #include "not_real.h"
@@ -12,3 +13,7 @@ void foo() {
   bar();
   baz();
 }
+
+// The listing cache is keyed by path only, so it is not used on top of an
+// overlay; not_real.h must not be rejected by the on-disk listing of %t.
+// CHECK-NOT: lookups rejected by directory listings
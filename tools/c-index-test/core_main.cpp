@@ -14,6 +14,7 @@
 #include "clang/Frontend/FrontendAction.h"
 #include "clang/Index/IndexingAction.h"
 #include "clang/Index/IndexDataConsumer.h"
+#include "clang/Index/IndexStore.h"
 #include "clang/Index/USRGeneration.h"
 #include "clang/Index/CodegenNameGenerator.h"
 #include "clang/Serialization/ASTReader.h"
@@ -33,6 +34,8 @@ namespace {
 enum class ActionType {
   None,
   PrintSourceSymbols,
+  IndexToStore,
+  PrintStoreOccurrences,
 };
 
 namespace options {
@@ -43,7 +46,12 @@ static cl::opt<ActionType>
 Action(cl::desc("Action:"), cl::init(ActionType::None),
        cl::values(
           clEnumValN(ActionType::PrintSourceSymbols,
-                     "print-source-symbols", "Print symbols from source")),
+                     "print-source-symbols", "Print symbols from source"),
+          clEnumValN(ActionType::IndexToStore,
+                     "index-to-store", "Write index data to an index store"),
+          clEnumValN(ActionType::PrintStoreOccurrences,
+                     "print-store-occurrences",
+                     "Print occurrences of a USR from an index store")),
        cl::cat(IndexTestCoreCategory));
 
 static cl::extrahelp MoreHelp(
@@ -61,6 +69,10 @@ IncludeLocals("include-locals", cl::desc("Print local symbols"));
 static cl::opt<std::string>
 ModuleFilePath("module-file",
                cl::desc("Path to module file to print symbols from"));
+static cl::opt<std::string>
+StorePath("store-path", cl::desc("Path to the index store"));
+static cl::opt<std::string>
+USR("usr", cl::desc("USR to print occurrences of"));
 static cl::opt<std::string>
   ModuleFormat("fmodule-format", cl::init("raw"),
         cl::desc("Container format for clang modules and PCH, 'raw' or 'obj'"));
@@ -235,6 +247,77 @@ static bool printSourceSymbolsFromModule(StringRef modulePath,
   return false;
 }
 
+//===----------------------------------------------------------------------===//
+// Index Store
+//===----------------------------------------------------------------------===//
+
+static bool indexToStore(ArrayRef<const char *> Args, StringRef StorePath,
+                         bool indexLocals) {
+  SmallVector<const char *, 4> ArgsWithProgName;
+  ArgsWithProgName.push_back("clang");
+  ArgsWithProgName.append(Args.begin(), Args.end());
+  IntrusiveRefCntPtr<DiagnosticsEngine>
+    Diags(CompilerInstance::createDiagnostics(new DiagnosticOptions));
+  auto CInvok = createInvocationFromCommandLine(ArgsWithProgName, Diags);
+  if (!CInvok)
+    return true;
+
+  // Skip translation units none of whose files changed since they were last
+  // written to the store.
+  const FrontendOptions &FEOpts = CInvok->getFrontendOpts();
+  if (FEOpts.Inputs.size() == 1 && FEOpts.Inputs[0].isFile()) {
+    std::string Error;
+    auto Reader = IndexStoreReader::open(StorePath, Error);
+    if (Reader && Reader->isUnitUpToDate(FEOpts.Inputs[0].getFile())) {
+      outs() << "unit is up-to-date: " << FEOpts.Inputs[0].getFile() << '\n';
+      return false;
+    }
+  }
+
+  IndexingOptions IndexOpts;
+  IndexOpts.IndexFunctionLocals = indexLocals;
+  std::unique_ptr<FrontendAction> IndexAction;
+  IndexAction = createIndexStoreAction(StorePath, IndexOpts,
+                                       /*WrappedAction=*/nullptr);
+
+  auto PCHContainerOps = std::make_shared<PCHContainerOperations>();
+  std::unique_ptr<ASTUnit> Unit(ASTUnit::LoadFromCompilerInvocationAction(
+      std::move(CInvok), PCHContainerOps, Diags, IndexAction.get()));
+
+  return !Unit;
+}
+
+static bool printStoreOccurrences(StringRef StorePath, StringRef USR) {
+  std::string Error;
+  auto Reader = IndexStoreReader::open(StorePath, Error);
+  if (!Reader) {
+    errs() << "error: " << Error << '\n';
+    return true;
+  }
+
+  raw_ostream &OS = outs();
+  Reader->foreachUnit([&](StringRef UnitName) -> bool {
+    OS << "unit: " << UnitName << '\n';
+    Reader->foreachUnitDependency(UnitName,
+                                  [&](const StoreUnitDependency &Dep) -> bool {
+      if (!Dep.RecordName.empty())
+        OS << "\tdep: " << Dep.FilePath << '\n';
+      return true;
+    });
+    return true;
+  });
+
+  Reader->foreachOccurrenceOfUSR(USR, /*RoleFilter=*/0,
+                                 [&](const StoreOccurrence &Occur) -> bool {
+    OS << Occur.FilePath << ':' << Occur.Line << ':' << Occur.Column << " | ";
+    OS << getSymbolKindString(Occur.Kind) << " | ";
+    printSymbolRoles(Occur.Roles, OS);
+    OS << '\n';
+    return true;
+  });
+  return false;
+}
+
 //===----------------------------------------------------------------------===//
 // Helper Utils
 //===----------------------------------------------------------------------===//
@@ -305,5 +388,24 @@ int indextest_core_main(int argc, const char **argv) {
     return printSourceSymbols(CompArgs, options::DumpModuleImports, options::IncludeLocals);
   }
 
+  if (options::Action == ActionType::IndexToStore ||
+      options::Action == ActionType::PrintStoreOccurrences) {
+    if (options::StorePath.empty()) {
+      errs() << "error: missing store path; pass '-store-path <path>'\n";
+      return 1;
+    }
+  }
+
+  if (options::Action == ActionType::IndexToStore) {
+    if (CompArgs.empty()) {
+      errs() << "error: missing compiler args; pass '-- <compiler arguments>'\n";
+      return 1;
+    }
+    return indexToStore(CompArgs, options::StorePath, options::IncludeLocals);
+  }
+
+  if (options::Action == ActionType::PrintStoreOccurrences)
+    return printStoreOccurrences(options::StorePath, options::USR);
+
   return 0;
 }
@@ -80,6 +80,12 @@ static cl::opt<bool> FixWhatYouCan(
     cl::desc(Options->getOptionHelpText(options::OPT_fix_what_you_can)),
     cl::cat(ClangCheckCategory));
 
+static cl::opt<bool> DeduplicateDiagnostics(
+    "deduplicate-diagnostics",
+    cl::desc("Report each diagnostic only once, even if it occurs in several "
+             "of the source files, e.g. in a header they all include"),
+    cl::cat(ClangCheckCategory));
+
 namespace {
 
 // FIXME: Move FixItRewriteInPlace from lib/Rewrite/Frontend/FrontendActions.cpp
@@ -171,6 +177,8 @@ int main(int argc, const char **argv) {
   Tool.appendArgumentsAdjuster(getInsertArgumentAdjuster(
       Analyze ? "--analyze" : "-fsyntax-only", ArgumentInsertPosition::BEGIN));
 
+  Tool.setDeduplicateDiagnostics(DeduplicateDiagnostics);
+
   ClangCheckActionFactory CheckFactory;
   std::unique_ptr<FrontendActionFactory> FrontendFactory;
 
@@ -16,13 +16,18 @@
 #include "clang/Basic/Diagnostic.h"
 #include "clang/Basic/DiagnosticOptions.h"
 #include "clang/Basic/FileManager.h"
+#include "clang/Basic/FileUtilities.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/Version.h"
 #include "clang/Format/Format.h"
 #include "clang/Rewrite/Core/Rewriter.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringSet.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
 #include "llvm/Support/Signals.h"
+#include "llvm/Support/ThreadPool.h"
 
 using namespace llvm;
 using clang::tooling::Replacements;
@@ -102,6 +107,20 @@ static cl::opt<bool> SortIncludes(
              "SortIncludes style flag"),
     cl::cat(ClangFormatCategory));
 
+static cl::opt<unsigned>
+    NumThreads("j",
+               cl::desc("The number of files to format concurrently when\n"
+                        "several files are given. 0 uses one thread per\n"
+                        "hardware thread."),
+               cl::init(1), cl::cat(ClangFormatCategory));
+
+static cl::opt<std::string>
+    CacheFile("cache-file",
+              cl::desc("With -i, skip the files this cache file records as\n"
+                       "already formatted with the same style, and record\n"
+                       "the files formatted by this run in it."),
+              cl::cat(ClangFormatCategory));
+
 static cl::list<std::string> FileNames(cl::Positional, cl::desc("[<file> ...]"),
                                        cl::cat(ClangFormatCategory));
 
@@ -125,8 +144,8 @@ static bool parseLineRange(StringRef Input, unsigned &FromLine,
          LineRange.second.getAsInteger(0, ToLine);
 }
 
-static bool fillRanges(MemoryBuffer *Code,
-                       std::vector<tooling::Range> &Ranges) {
+static bool fillRanges(MemoryBuffer *Code, std::vector<tooling::Range> &Ranges,
+                       raw_ostream &ErrOS) {
   IntrusiveRefCntPtr<vfs::InMemoryFileSystem> InMemoryFileSystem(
       new vfs::InMemoryFileSystem);
   FileManager Files(FileSystemOptions(), InMemoryFileSystem);
@@ -138,18 +157,18 @@ static bool fillRanges(MemoryBuffer *Code,
                                  InMemoryFileSystem.get());
   if (!LineRanges.empty()) {
     if (!Offsets.empty() || !Lengths.empty()) {
-      errs() << "error: cannot use -lines with -offset/-length\n";
+      ErrOS << "error: cannot use -lines with -offset/-length\n";
       return true;
     }
 
     for (unsigned i = 0, e = LineRanges.size(); i < e; ++i) {
       unsigned FromLine, ToLine;
       if (parseLineRange(LineRanges[i], FromLine, ToLine)) {
-        errs() << "error: invalid <start line>:<end line> pair\n";
+        ErrOS << "error: invalid <start line>:<end line> pair\n";
         return true;
       }
       if (FromLine > ToLine) {
-        errs() << "error: start line should be less than end line\n";
+        ErrOS << "error: start line should be less than end line\n";
         return true;
       }
       SourceLocation Start = Sources.translateLineCol(ID, FromLine, 1);
@@ -163,26 +182,28 @@ static bool fillRanges(MemoryBuffer *Code,
     return false;
   }
 
-  if (Offsets.empty())
-    Offsets.push_back(0);
-  if (Offsets.size() != Lengths.size() &&
-      !(Offsets.size() == 1 && Lengths.empty())) {
-    errs() << "error: number of -offset and -length arguments must match.\n";
+  // Files may be formatted concurrently, so do not modify the options.
+  std::vector<unsigned> Starts(Offsets.begin(), Offsets.end());
+  if (Starts.empty())
+    Starts.push_back(0);
+  if (Starts.size() != Lengths.size() &&
+      !(Starts.size() == 1 && Lengths.empty())) {
+    ErrOS << "error: number of -offset and -length arguments must match.\n";
     return true;
   }
-  for (unsigned i = 0, e = Offsets.size(); i != e; ++i) {
-    if (Offsets[i] >= Code->getBufferSize()) {
-      errs() << "error: offset " << Offsets[i] << " is outside the file\n";
+  for (unsigned i = 0, e = Starts.size(); i != e; ++i) {
+    if (Starts[i] >= Code->getBufferSize()) {
+      ErrOS << "error: offset " << Starts[i] << " is outside the file\n";
       return true;
     }
     SourceLocation Start =
-        Sources.getLocForStartOfFile(ID).getLocWithOffset(Offsets[i]);
+        Sources.getLocForStartOfFile(ID).getLocWithOffset(Starts[i]);
     SourceLocation End;
     if (i < Lengths.size()) {
-      if (Offsets[i] + Lengths[i] > Code->getBufferSize()) {
-        errs() << "error: invalid length " << Lengths[i]
-               << ", offset + length (" << Offsets[i] + Lengths[i]
-               << ") is outside the file.\n";
+      if (Starts[i] + Lengths[i] > Code->getBufferSize()) {
+        ErrOS << "error: invalid length " << Lengths[i]
+              << ", offset + length (" << Starts[i] + Lengths[i]
+              << ") is outside the file.\n";
         return true;
       }
       End = Start.getLocWithOffset(Lengths[i]);
@@ -196,48 +217,100 @@ static bool fillRanges(MemoryBuffer *Code,
   return false;
 }
 
-static void outputReplacementXML(StringRef Text) {
+static void outputReplacementXML(StringRef Text, raw_ostream &OS) {
   // FIXME: When we sort includes, we need to make sure the stream is correct
   // utf-8.
   size_t From = 0;
   size_t Index;
   while ((Index = Text.find_first_of("\n\r<&", From)) != StringRef::npos) {
-    outs() << Text.substr(From, Index - From);
+    OS << Text.substr(From, Index - From);
     switch (Text[Index]) {
     case '\n':
-      outs() << "&#10;";
+      OS << "&#10;";
       break;
     case '\r':
-      outs() << "&#13;";
+      OS << "&#13;";
       break;
     case '<':
-      outs() << "&lt;";
+      OS << "&lt;";
       break;
     case '&':
-      outs() << "&amp;";
+      OS << "&amp;";
       break;
     default:
       llvm_unreachable("Unexpected character encountered!");
     }
     From = Index + 1;
   }
-  outs() << Text.substr(From);
+  OS << Text.substr(From);
 }
 
-static void outputReplacementsXML(const Replacements &Replaces) {
+static void outputReplacementsXML(const Replacements &Replaces,
+                                  raw_ostream &OS) {
   for (const auto &R : Replaces) {
-    outs() << "<replacement "
-           << "offset='" << R.getOffset() << "' "
-           << "length='" << R.getLength() << "'>";
-    outputReplacementXML(R.getReplacementText());
-    outs() << "</replacement>\n";
+    OS << "<replacement "
+       << "offset='" << R.getOffset() << "' "
+       << "length='" << R.getLength() << "'>";
+    outputReplacementXML(R.getReplacementText(), OS);
+    OS << "</replacement>\n";
   }
 }
 
+/// \brief Fingerprints of files known to be formatted, read from -cache-file.
+/// Only read while files are formatted.
+static llvm::StringSet<> FormattedFiles;
+
+/// \brief Compute the fingerprint recorded in -cache-file for \p Code
+/// formatted with \p Style as the file \p FileName.
+///
+/// The file name is part of the fingerprint because include sorting depends
+/// on it, so the same code may be formatted differently in another file.
+static std::string getFormattedFingerprint(const FormatStyle &Style,
+                                           StringRef FileName,
+                                           StringRef Code) {
+  llvm::MD5 Hash;
+  Hash.update(clang::getClangToolFullVersion("clang-format"));
+  Hash.update(configurationAsText(Style));
+  // Separate the name from the code, so that the boundary is unambiguous.
+  Hash.update(FileName);
+  Hash.update(StringRef("\0", 1));
+  Hash.update(Code);
+  llvm::MD5::MD5Result Result;
+  Hash.final(Result);
+  SmallString<32> HexHash;
+  llvm::MD5::stringifyResult(Result, HexHash);
+  return HexHash.str();
+}
+
+static void readCacheFile(StringRef Path) {
+  ErrorOr<std::unique_ptr<MemoryBuffer>> BufferOrErr =
+      MemoryBuffer::getFile(Path);
+  // A missing cache file just means nothing is known to be formatted.
+  if (!BufferOrErr)
+    return;
+  SmallVector<StringRef, 64> Lines;
+  (*BufferOrErr)->getBuffer().split(Lines, '\n', /*MaxSplit=*/-1,
+                                    /*KeepEmpty=*/false);
+  for (StringRef Line : Lines)
+    FormattedFiles.insert(Line.trim());
+}
+
 // Returns true on error.
-static bool format(StringRef FileName) {
+static bool writeCacheFile(StringRef Path) {
+  std::string Contents;
+  llvm::raw_string_ostream OS(Contents);
+  for (const auto &Entry : FormattedFiles)
+    OS << Entry.getKey() << '\n';
+  return writeFileAtomically(Path, OS.str());
+}
+
+// Returns true on error. Results are written to \p OS and errors to \p ErrOS.
+// If \p Fingerprint is non-null and the file is formatted in place, it is set
+// to the fingerprint of the formatted file.
+static bool format(StringRef FileName, raw_ostream &OS, raw_ostream &ErrOS,
+                   std::string *Fingerprint = nullptr) {
   if (!OutputXML && Inplace && FileName == "-") {
-    errs() << "error: cannot use -i when reading from stdin.\n";
+    ErrOS << "error: cannot use -i when reading from stdin.\n";
     return false;
   }
   // On Windows, overwriting a file with an open file mapping doesn't work,
@@ -246,32 +319,45 @@ static bool format(StringRef FileName) {
       !OutputXML && Inplace ? MemoryBuffer::getFileAsStream(FileName) :
                               MemoryBuffer::getFileOrSTDIN(FileName);
   if (std::error_code EC = CodeOrErr.getError()) {
-    errs() << EC.message() << "\n";
+    ErrOS << EC.message() << "\n";
     return true;
   }
   std::unique_ptr<llvm::MemoryBuffer> Code = std::move(CodeOrErr.get());
   if (Code->getBufferSize() == 0)
     return false; // Empty files are formatted correctly.
   std::vector<tooling::Range> Ranges;
-  if (fillRanges(Code.get(), Ranges))
+  if (fillRanges(Code.get(), Ranges, ErrOS))
     return true;
   StringRef AssumedFileName = (FileName == "-") ? AssumeFileName : FileName;
 
   llvm::Expected<FormatStyle> FormatStyle =
       getStyle(Style, AssumedFileName, FallbackStyle, Code->getBuffer());
   if (!FormatStyle) {
-    llvm::errs() << llvm::toString(FormatStyle.takeError()) << "\n";
+    ErrOS << llvm::toString(FormatStyle.takeError()) << "\n";
     return true;
   }
 
   if (SortIncludes.getNumOccurrences() != 0)
     FormatStyle->SortIncludes = SortIncludes;
+
+  // Whole files formatted in place can be skipped if they are known to be
+  // formatted already.
+  bool UseCache = !CacheFile.empty() && Inplace && !OutputXML &&
+                  Offsets.empty() && Lengths.empty() && LineRanges.empty();
+  if (UseCache) {
+    std::string Unchanged =
+        getFormattedFingerprint(*FormatStyle, AssumedFileName,
+                                Code->getBuffer());
+    if (FormattedFiles.count(Unchanged))
+      return false;
+  }
+
   unsigned CursorPosition = Cursor;
   Replacements Replaces = sortIncludes(*FormatStyle, Code->getBuffer(), Ranges,
                                        AssumedFileName, &CursorPosition);
   auto ChangedCode = tooling::applyAllReplacements(Code->getBuffer(), Replaces);
   if (!ChangedCode) {
-    llvm::errs() << llvm::toString(ChangedCode.takeError()) << "\n";
+    ErrOS << llvm::toString(ChangedCode.takeError()) << "\n";
     return true;
   }
   // Get new affected ranges after sorting `#includes`.
@@ -281,19 +367,19 @@ static bool format(StringRef FileName) {
                                         AssumedFileName, &Status);
   Replaces = Replaces.merge(FormatChanges);
   if (OutputXML) {
-    outs() << "<?xml version='1.0'?>\n<replacements "
-              "xml:space='preserve' incomplete_format='"
-           << (Status.FormatComplete ? "false" : "true") << "'";
+    OS << "<?xml version='1.0'?>\n<replacements "
+          "xml:space='preserve' incomplete_format='"
+       << (Status.FormatComplete ? "false" : "true") << "'";
     if (!Status.FormatComplete)
-      outs() << " line=" << Status.Line;
-    outs() << ">\n";
+      OS << " line=" << Status.Line;
+    OS << ">\n";
     if (Cursor.getNumOccurrences() != 0)
-      outs() << "<cursor>"
-             << FormatChanges.getShiftedCodePosition(CursorPosition)
-             << "</cursor>\n";
+      OS << "<cursor>"
+         << FormatChanges.getShiftedCodePosition(CursorPosition)
+         << "</cursor>\n";
 
-    outputReplacementsXML(Replaces);
-    outs() << "</replacements>\n";
+    outputReplacementsXML(Replaces, OS);
+    OS << "</replacements>\n";
   } else {
     IntrusiveRefCntPtr<vfs::InMemoryFileSystem> InMemoryFileSystem(
         new vfs::InMemoryFileSystem);
@@ -309,22 +395,78 @@ static bool format(StringRef FileName) {
     if (Inplace) {
       if (Rewrite.overwriteChangedFiles())
         return true;
+      // Only record files that were formatted completely; incomplete files
+      // must be looked at again.
+      if (UseCache && Fingerprint && Status.FormatComplete) {
+        std::string Formatted;
+        llvm::raw_string_ostream FormattedOS(Formatted);
+        Rewrite.getEditBuffer(ID).write(FormattedOS);
+        *Fingerprint = getFormattedFingerprint(*FormatStyle, AssumedFileName,
+                                               FormattedOS.str());
+      }
     } else {
       if (Cursor.getNumOccurrences() != 0) {
-        outs() << "{ \"Cursor\": "
-               << FormatChanges.getShiftedCodePosition(CursorPosition)
-               << ", \"IncompleteFormat\": "
-               << (Status.FormatComplete ? "false" : "true");
+        OS << "{ \"Cursor\": "
+           << FormatChanges.getShiftedCodePosition(CursorPosition)
+           << ", \"IncompleteFormat\": "
+           << (Status.FormatComplete ? "false" : "true");
         if (!Status.FormatComplete)
-          outs() << ", \"Line\": " << Status.Line;
-        outs() << " }\n";
+          OS << ", \"Line\": " << Status.Line;
+        OS << " }\n";
       }
-      Rewrite.getEditBuffer(ID).write(outs());
+      Rewrite.getEditBuffer(ID).write(OS);
     }
   }
   return false;
 }
 
+/// \brief The buffered outcome of formatting one of several files.
+struct FileResult {
+  std::string Output;
+  std::string Errors;
+  std::string Fingerprint;
+  bool Error = false;
+};
+
+// Returns true on error.
+static bool formatFiles(ArrayRef<std::string> Files) {
+  if (!CacheFile.empty())
+    readCacheFile(CacheFile);
+
+  // Buffer the output of each file, so that it is printed in command line
+  // order no matter in which order the files are formatted.
+  std::vector<FileResult> Results(Files.size());
+  auto FormatFile = [&](unsigned I) {
+    FileResult &Result = Results[I];
+    llvm::raw_string_ostream OS(Result.Output), ErrOS(Result.Errors);
+    Result.Error = format(Files[I], OS, ErrOS, &Result.Fingerprint);
+  };
+  if (NumThreads == 1) {
+    for (unsigned I = 0, E = Files.size(); I != E; ++I)
+      FormatFile(I);
+  } else {
+    std::unique_ptr<llvm::ThreadPool> Pool(
+        NumThreads == 0 ? new llvm::ThreadPool()
+                        : new llvm::ThreadPool(NumThreads));
+    for (unsigned I = 0, E = Files.size(); I != E; ++I)
+      Pool->async(FormatFile, I);
+    Pool->wait();
+  }
+
+  bool Error = false;
+  for (const FileResult &Result : Results) {
+    outs() << Result.Output;
+    errs() << Result.Errors;
+    Error |= Result.Error;
+    if (!Result.Fingerprint.empty())
+      FormattedFiles.insert(Result.Fingerprint);
+  }
+
+  if (!CacheFile.empty() && writeCacheFile(CacheFile))
+    errs() << "warning: could not write cache file '" << CacheFile << "'\n";
+  return Error;
+}
+
 }  // namespace format
 }  // namespace clang
 
@@ -367,19 +509,16 @@ int main(int argc, const char **argv) {
   bool Error = false;
   switch (FileNames.size()) {
   case 0:
-    Error = clang::format::format("-");
-    break;
-  case 1:
-    Error = clang::format::format(FileNames[0]);
+    Error = clang::format::format("-", outs(), errs());
     break;
   default:
-    if (!Offsets.empty() || !Lengths.empty() || !LineRanges.empty()) {
+    if (FileNames.size() > 1 &&
+        (!Offsets.empty() || !Lengths.empty() || !LineRanges.empty())) {
       errs() << "error: -offset, -length and -lines can only be used for "
                 "single file.\n";
       return 1;
     }
-    for (unsigned i = 0; i < FileNames.size(); ++i)
-      Error |= clang::format::format(FileNames[i]);
+    Error = clang::format::formatFiles(FileNames);
     break;
   }
   return Error ? 1 : 0;
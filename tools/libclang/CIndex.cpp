@@ -33,6 +33,7 @@
 #include "clang/Frontend/FrontendDiagnostic.h"
 #include "clang/Index/CodegenNameGenerator.h"
 #include "clang/Index/CommentToXML.h"
+#include "clang/Index/USRGeneration.h"
 #include "clang/Lex/HeaderSearch.h"
 #include "clang/Lex/Lexer.h"
 #include "clang/Lex/PreprocessingRecord.h"
@@ -81,6 +82,7 @@ CXTranslationUnit cxtu::MakeCXTranslationUnit(CIndexer *CIdx,
   D->Diagnostics = nullptr;
   D->OverridenCursorsPool = createOverridenCXCursorsPool();
   D->CommentToXML = nullptr;
+  D->USRs = nullptr;
   return D;
 }
 
@@ -3307,6 +3309,8 @@ clang_parseTranslationUnit_Impl(CXIndex CIdx, const char *source_filename,
   bool IncludeBriefCommentsInCodeCompletion
     = options & CXTranslationUnit_IncludeBriefCommentsInCodeCompletion;
   bool SkipFunctionBodies = options & CXTranslationUnit_SkipFunctionBodies;
+  bool ParseDeclarationsOnly =
+      options & CXTranslationUnit_ParseDeclarationsOnly;
   bool SingleFileParse = options & CXTranslationUnit_SingleFileParse;
   bool ForSerialization = options & CXTranslationUnit_ForSerialization;
 
@@ -3395,7 +3399,7 @@ clang_parseTranslationUnit_Impl(CXIndex CIdx, const char *source_filename,
       /*AllowPCHWithCompilerErrors=*/true, SkipFunctionBodies, SingleFileParse,
       /*UserFilesAreVolatile=*/true, ForSerialization,
       CXXIdx->getPCHContainerOperations()->getRawReader().getFormat(),
-      &ErrUnit));
+      &ErrUnit, /*VFS=*/nullptr, ParseDeclarationsOnly));
 
   // Early failures in LoadFromCommandLine may return with ErrUnit unset.
   if (!Unit && !ErrUnit)
@@ -3916,6 +3920,7 @@ void clang_disposeTranslationUnit(CXTranslationUnit CTUnit) {
     delete static_cast<CXDiagnosticSetImpl *>(CTUnit->Diagnostics);
     disposeOverridenCXCursorsPool(CTUnit->OverridenCursorsPool);
     delete CTUnit->CommentToXML;
+    delete CTUnit->USRs;
     delete CTUnit;
   }
 }
@@ -3927,6 +3932,9 @@ unsigned clang_suspendTranslationUnit(CXTranslationUnit CTUnit) {
     if (Unit && Unit->isUnsafeToFree())
       return false;
 
+    // The cached USRs are keyed on declarations of the AST being discarded.
+    if (CTUnit->USRs)
+      CTUnit->USRs->clear();
     Unit->ResetForParse();
     return true;
   }
@@ -3952,6 +3960,10 @@ clang_reparseTranslationUnit_Impl(CXTranslationUnit TU,
   delete static_cast<CXDiagnosticSetImpl*>(TU->Diagnostics);
   TU->Diagnostics = nullptr;
 
+  // The cached USRs are keyed on declarations of the AST being replaced.
+  if (TU->USRs)
+    TU->USRs->clear();
+
   CIndexer *CXXIdx = TU->CIdx;
   if (CXXIdx->isOptEnabled(CXGlobalOpt_ThreadBackgroundPriorityForEditing))
     setThreadBackgroundPriority();
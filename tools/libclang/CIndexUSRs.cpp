@@ -52,11 +52,16 @@ CXString clang_getCursorUSR(CXCursor C) {
     if (!buf)
       return cxstring::createEmpty();
 
-    bool Ignore = cxcursor::getDeclCursorUSR(D, buf->Data);
-    if (Ignore) {
+    // Clients commonly ask for the USRs of the same declarations repeatedly;
+    // keep them in a per-translation unit cache.
+    if (!TU->USRs)
+      TU->USRs = new USRCache();
+    StringRef USR;
+    if (TU->USRs->getUSR(D, USR)) {
       buf->dispose();
       return cxstring::createEmpty();
     }
+    buf->Data.append(USR.begin(), USR.end());
 
     // Return the C-string, but don't make a copy since it is already in
     // the string buffer.
@@ -23,6 +23,7 @@ namespace clang {
   class CIndexer;
 namespace index {
 class CommentToXMLConverter;
+class USRCache;
 } // namespace index
 } // namespace clang
 
@@ -33,6 +34,7 @@ struct CXTranslationUnitImpl {
   void *Diagnostics;
   void *OverridenCursorsPool;
   clang::index::CommentToXMLConverter *CommentToXML;
+  clang::index::USRCache *USRs;
 };
 
 struct CXTargetInfoImpl {
@@ -540,6 +540,8 @@ static CXErrorCode clang_indexSourceFile_Impl(
       CInvok->getLangOpts()->CPlusPlus;
   if (SkipBodies)
     CInvok->getFrontendOpts().SkipFunctionBodies = true;
+  if (TU_options & CXTranslationUnit_ParseDeclarationsOnly)
+    CInvok->getFrontendOpts().ParseDeclarationsOnly = true;
 
   auto DataConsumer =
     std::make_shared<CXIndexDataConsumer>(client_data, CB, index_options,
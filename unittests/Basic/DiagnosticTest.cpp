@@ -72,4 +72,37 @@ TEST(DiagnosticTest, suppressAfterFatalError) {
   }
 }
 
+// Check that isIgnored stays accurate as mappings enable diagnostics that
+// were disabled everywhere.
+TEST(DiagnosticTest, isIgnoredAfterMappingChanges) {
+  DiagnosticsEngine Diags(new DiagnosticIDs(),
+                          new DiagnosticOptions,
+                          new IgnoringDiagConsumer());
+
+  EXPECT_TRUE(Diags.isIgnored(diag::warn_cxx98_compat_longlong,
+                              SourceLocation()));
+  Diags.setSeverity(diag::warn_cxx98_compat_longlong,
+                    diag::Severity::Warning, SourceLocation());
+  EXPECT_FALSE(Diags.isIgnored(diag::warn_cxx98_compat_longlong,
+                               SourceLocation()));
+  Diags.setSeverity(diag::warn_cxx98_compat_longlong,
+                    diag::Severity::Ignored, SourceLocation());
+  EXPECT_TRUE(Diags.isIgnored(diag::warn_cxx98_compat_longlong,
+                              SourceLocation()));
+
+  // -pedantic enables extensions that are not mapped explicitly.
+  EXPECT_TRUE(Diags.isIgnored(diag::ext_c99_longlong, SourceLocation()));
+  Diags.setExtensionHandlingBehavior(diag::Severity::Warning);
+  EXPECT_FALSE(Diags.isIgnored(diag::ext_c99_longlong, SourceLocation()));
+
+  // -Weverything enables warnings that are not mapped explicitly.
+  EXPECT_TRUE(Diags.isIgnored(diag::warn_cxx98_compat_variadic_templates,
+                              SourceLocation()));
+  Diags.setEnableAllWarnings(true);
+  EXPECT_FALSE(Diags.isIgnored(diag::warn_cxx98_compat_variadic_templates,
+                               SourceLocation()));
+  EXPECT_TRUE(Diags.isIgnored(diag::warn_cxx98_compat_longlong,
+                              SourceLocation()));
+}
+
 }
@@ -10,8 +10,10 @@
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/FileSystemOptions.h"
 #include "clang/Basic/FileSystemStatCache.h"
+#include "clang/Basic/VirtualFileSystem.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Config/llvm-config.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "gtest/gtest.h"
 
@@ -294,6 +296,37 @@ TEST_F(FileManagerTest, getVirtualFileWithDifferentName) {
   EXPECT_EQ(123, file2->getSize());
 }
 
+// Prefetched stats answer the file manager's queries without going to the
+// file system again.
+TEST_F(FileManagerTest, getFileUsesPrefetchedStats) {
+  IntrusiveRefCntPtr<vfs::InMemoryFileSystem> FS(
+      new vfs::InMemoryFileSystem);
+  FS->addFile("/dir/a.h", 0, MemoryBuffer::getMemBuffer("int a;"));
+  FS->addFile("/dir/b.h", 0, MemoryBuffer::getMemBuffer("int bb;"));
+
+  std::vector<std::string> Paths = {"/dir", "/dir/a.h", "/dir/b.h",
+                                    "/dir/missing.h"};
+  auto Prefetched = llvm::make_unique<PrefetchedStatCache>();
+  Prefetched->prefetch(Paths, *FS, /*NumThreads=*/2);
+  EXPECT_EQ(4U, Prefetched->size());
+
+  // Query through a file system that has none of these files.
+  IntrusiveRefCntPtr<vfs::InMemoryFileSystem> EmptyFS(
+      new vfs::InMemoryFileSystem);
+  FileManager Manager(options, EmptyFS);
+  Manager.addStatCache(std::move(Prefetched));
+
+  const FileEntry *A = Manager.getFile("/dir/a.h");
+  ASSERT_TRUE(A != nullptr);
+  EXPECT_EQ(6, A->getSize());
+  const FileEntry *B = Manager.getFile("/dir/b.h");
+  ASSERT_TRUE(B != nullptr);
+  EXPECT_EQ(7, B->getSize());
+  EXPECT_NE(A->getUniqueID(), B->getUniqueID());
+  EXPECT_EQ(nullptr, Manager.getFile("/dir/missing.h"));
+  EXPECT_EQ(nullptr, Manager.getDirectory("/dir/a.h"));
+}
+
 #endif  // !LLVM_ON_WIN32
 
 } // anonymous namespace
@@ -379,4 +379,116 @@ TEST_F(SourceManagerTest, isBeforeInTranslationUnitWithMacroInInclude) {
 
 #endif
 
+TEST_F(SourceManagerTest, getFileIDManyLocalEntries) {
+  std::unique_ptr<llvm::MemoryBuffer> Buf =
+      llvm::MemoryBuffer::getMemBuffer("int x;\n");
+  FileID MainFileID = SourceMgr.createFileID(std::move(Buf));
+  SourceMgr.setMainFileID(MainFileID);
+  SourceLocation Loc = SourceMgr.getLocForStartOfFile(MainFileID);
+
+  // Create enough expansions of varying lengths to span many pages of the
+  // source location address space, as in macro-heavy code.
+  const unsigned NumExpansions = 100000;
+  std::vector<SourceLocation> Starts;
+  for (unsigned I = 0; I != NumExpansions; ++I)
+    Starts.push_back(SourceMgr.createExpansionLoc(Loc, Loc, Loc, I % 37));
+
+  // Look up the first and last offset of each expansion in an order that
+  // defeats the cache of the last lookup.
+  for (unsigned I = 0; I != NumExpansions; ++I) {
+    unsigned Index = (I * 7919) % NumExpansions;
+    SourceLocation Start = Starts[Index];
+    std::pair<FileID, unsigned> Decomposed = SourceMgr.getDecomposedLoc(Start);
+    ASSERT_EQ(0u, Decomposed.second);
+    if (Index > 0)
+      ASSERT_NE(SourceMgr.getFileID(Starts[Index - 1]), Decomposed.first);
+    ASSERT_EQ(std::make_pair(Decomposed.first, Index % 37),
+              SourceMgr.getDecomposedLoc(Start.getLocWithOffset(Index % 37)));
+  }
+}
+
+// Loads expansions of a fixed length on demand, like a module file.
+class TestSLocEntrySource : public ExternalSLocEntrySource {
+  SourceManager &SM;
+  SourceLocation SpellingLoc;
+
+public:
+  struct Block {
+    int BaseID;
+    unsigned BaseOffset;
+  };
+  std::vector<Block> Blocks;
+  static const unsigned EntrySize = 4;
+  unsigned NumLoaded = 0;
+  SourceLocation LastLoadedLoc;
+
+  TestSLocEntrySource(SourceManager &SM, SourceLocation SpellingLoc)
+      : SM(SM), SpellingLoc(SpellingLoc) {}
+
+  void addBlock(unsigned NumEntries) {
+    std::pair<int, unsigned> Base =
+        SM.AllocateLoadedSLocEntries(NumEntries, NumEntries * EntrySize);
+    Blocks.push_back({Base.first, Base.second});
+  }
+
+  bool ReadSLocEntry(int ID) override {
+    // Blocks allocated later have lower IDs and offsets.
+    for (const Block &B : Blocks) {
+      if (ID < B.BaseID)
+        continue;
+      ++NumLoaded;
+      LastLoadedLoc = SM.createExpansionLoc(
+          SpellingLoc, SpellingLoc, SpellingLoc, EntrySize - 1, ID,
+          B.BaseOffset + (ID - B.BaseID) * EntrySize);
+      return false;
+    }
+    return true;
+  }
+
+  std::pair<SourceLocation, StringRef> getModuleImportLoc(int ID) override {
+    return std::make_pair(SourceLocation(), "");
+  }
+};
+
+TEST_F(SourceManagerTest, getFileIDLoadedEntries) {
+  std::unique_ptr<llvm::MemoryBuffer> Buf =
+      llvm::MemoryBuffer::getMemBuffer("int x;\n");
+  FileID MainFileID = SourceMgr.createFileID(std::move(Buf));
+  SourceMgr.setMainFileID(MainFileID);
+
+  TestSLocEntrySource Source(SourceMgr,
+                             SourceMgr.getLocForStartOfFile(MainFileID));
+  SourceMgr.setExternalSLocEntrySource(&Source);
+  const unsigned NumBlocks = 8;
+  const unsigned NumEntries = 10000;
+  for (unsigned I = 0; I != NumBlocks; ++I)
+    Source.addBlock(NumEntries);
+
+  // Load the entry with the lowest offset to get at the loaded locations.
+  SourceMgr.getLoadedSLocEntry(NumBlocks * NumEntries - 1);
+  SourceLocation BaseLoc = Source.LastLoadedLoc;
+  unsigned BaseOffset = Source.Blocks.back().BaseOffset;
+  Source.NumLoaded = 0;
+
+  // The binary search of a lookup is confined to the block containing the
+  // offset, so only a few entries get deserialized.
+  const TestSLocEntrySource::Block &Middle = Source.Blocks[NumBlocks / 2];
+  unsigned Start = Middle.BaseOffset + (NumEntries / 3) * Source.EntrySize;
+  std::pair<FileID, unsigned> Decomposed = SourceMgr.getDecomposedLoc(
+      BaseLoc.getLocWithOffset(Start + 1 - BaseOffset));
+  EXPECT_EQ(Start, SourceMgr.getSLocEntry(Decomposed.first).getOffset());
+  EXPECT_EQ(1u, Decomposed.second);
+  EXPECT_LT(Source.NumLoaded, 64u);
+
+  for (const TestSLocEntrySource::Block &B : Source.Blocks) {
+    for (unsigned I = 0; I < NumEntries; I += 97) {
+      Start = B.BaseOffset + I * Source.EntrySize;
+      Decomposed = SourceMgr.getDecomposedLoc(BaseLoc.getLocWithOffset(
+          Start + I % Source.EntrySize - BaseOffset));
+      ASSERT_EQ(Start, SourceMgr.getSLocEntry(Decomposed.first).getOffset());
+      ASSERT_EQ(I % Source.EntrySize, Decomposed.second);
+    }
+  }
+}
+
 } // anonymous namespace
@@ -5727,6 +5727,45 @@ TEST_F(FormatTest, IndentationWithinColumnLimitNotPossible) {
                getLLVMStyleWithColumns(20));
 }
 
+TEST_F(FormatTest, LineBreakingSearchWithUnavoidableExcessCharacters) {
+  // The search is guided by the excess characters that the tokens up to the
+  // next possible break cause; that bound must not change the result.
+  FormatStyle Style = getLLVMStyleWithColumns(20);
+  verifyFormat("int aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa;", Style);
+  verifyFormat("f(aaaaaaaaaaaaaaaaaaaaaaaaaa);", Style);
+  verifyFormat("f(a,\n"
+               "  bbbbbbbbbbbbbbbbbbbbbbbbb);",
+               Style);
+}
+
+TEST_F(FormatTest, ReusesLineBreaksOnlyForIdenticalLines) {
+  // Formatting lines together, when later lines can reuse the line breaks of
+  // earlier ones, gives the same result as formatting each line on its own.
+  std::string Call = "aaaaaaaaaaaaaaaaaaaaaaa(bbbbbbbbbbbbbbbbbbbbb, "
+                     "cccccccccccccccccccccc, dddddddddddddddddddd);\n";
+  std::string FormattedCall = format(Call);
+  EXPECT_EQ(FormattedCall + FormattedCall + FormattedCall,
+            format(Call + Call + Call));
+
+  // These only differ in the text of a literal of the same width, but a break
+  // is forced after a literal ending in a newline.
+  std::string NewlineLiteral =
+      "llvm::errs() << aaaaaaaaaaaaaaaaaaaaaa << \"\\n\" << "
+      "bbbbbbbbbbbbbbbbbbbbbb << \"\\n\";\n";
+  std::string PlainLiteral =
+      "llvm::errs() << aaaaaaaaaaaaaaaaaaaaaa << \"ab\" << "
+      "bbbbbbbbbbbbbbbbbbbbbb << \"\\n\";\n";
+  std::string FormattedNewlineLiteral = format(NewlineLiteral);
+  std::string FormattedPlainLiteral = format(PlainLiteral);
+  EXPECT_EQ("llvm::errs() << aaaaaaaaaaaaaaaaaaaaaa << \"\\n\"\n"
+            "             << bbbbbbbbbbbbbbbbbbbbbb << \"\\n\";\n",
+            FormattedNewlineLiteral);
+  EXPECT_EQ(FormattedNewlineLiteral + FormattedPlainLiteral,
+            format(NewlineLiteral + PlainLiteral));
+  EXPECT_EQ(FormattedPlainLiteral + FormattedNewlineLiteral,
+            format(PlainLiteral + NewlineLiteral));
+}
+
 TEST_F(FormatTest, IncorrectAccessSpecifier) {
   verifyFormat("public:");
   verifyFormat("class A {\n"
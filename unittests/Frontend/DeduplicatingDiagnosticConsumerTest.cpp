@@ -0,0 +1,115 @@
+//===- unittests/Frontend/DeduplicatingDiagnosticConsumerTest.cpp ---------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Frontend/DeduplicatingDiagnosticConsumer.h"
+#include "clang/Basic/DiagnosticIDs.h"
+#include "clang/Basic/DiagnosticOptions.h"
+#include "clang/Frontend/SerializedDiagnosticPrinter.h"
+#include "clang/Frontend/SerializedDiagnosticReader.h"
+#include "clang/Frontend/TextDiagnosticBuffer.h"
+#include "llvm/Support/FileSystem.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace clang;
+
+namespace {
+
+TEST(DeduplicatingDiagnosticConsumerTest, DropsRepeatedDiagnostics) {
+  TextDiagnosticBuffer *Buffer = new TextDiagnosticBuffer();
+  DeduplicatingDiagnosticConsumer *Dedup = new DeduplicatingDiagnosticConsumer(
+      std::unique_ptr<DiagnosticConsumer>(Buffer));
+  DiagnosticsEngine Diags(new DiagnosticIDs(), new DiagnosticOptions, Dedup);
+
+  Diags.Report(diag::warn_mt_message) << "first";
+  Diags.Report(diag::note_matching) << "first";
+  Diags.Report(diag::warn_mt_message) << "second";
+  Diags.Report(diag::warn_mt_message) << "first";
+  // Notes of a dropped diagnostic are dropped with it.
+  Diags.Report(diag::note_matching) << "first";
+  // Fatal errors are not repeated by the engine itself, so use a plain one.
+  Diags.Report(diag::err_target_unknown_cpu) << "cpu";
+  Diags.Report(diag::err_target_unknown_cpu) << "cpu";
+
+  EXPECT_EQ(2, Buffer->warn_end() - Buffer->warn_begin());
+  EXPECT_EQ(1, Buffer->note_end() - Buffer->note_begin());
+  EXPECT_EQ(1, Buffer->err_end() - Buffer->err_begin());
+  EXPECT_EQ(3U, Dedup->getDeduplicationSet().getNumUnique());
+  EXPECT_EQ(2U, Dedup->getDeduplicationSet().getNumDuplicates());
+}
+
+TEST(DeduplicatingDiagnosticConsumerTest, SharesSetAcrossEngines) {
+  IntrusiveRefCntPtr<DiagnosticDeduplicationSet> Seen(
+      new DiagnosticDeduplicationSet());
+
+  TextDiagnosticBuffer *Buffer1 = new TextDiagnosticBuffer();
+  DiagnosticsEngine Diags1(new DiagnosticIDs(), new DiagnosticOptions,
+                           new DeduplicatingDiagnosticConsumer(
+                               std::unique_ptr<DiagnosticConsumer>(Buffer1),
+                               Seen));
+  TextDiagnosticBuffer *Buffer2 = new TextDiagnosticBuffer();
+  DiagnosticsEngine Diags2(new DiagnosticIDs(), new DiagnosticOptions,
+                           new DeduplicatingDiagnosticConsumer(
+                               std::unique_ptr<DiagnosticConsumer>(Buffer2),
+                               Seen));
+
+  Diags1.Report(diag::warn_mt_message) << "shared";
+  Diags2.Report(diag::warn_mt_message) << "shared";
+  Diags2.Report(diag::warn_mt_message) << "only in the second";
+
+  EXPECT_EQ(1, Buffer1->warn_end() - Buffer1->warn_begin());
+  EXPECT_EQ(1, Buffer2->warn_end() - Buffer2->warn_begin());
+  EXPECT_EQ("only in the second", Buffer2->warn_begin()->second);
+  EXPECT_EQ(1U, Seen->getNumDuplicates());
+}
+
+/// Collects the messages of the diagnostics in a serialized diagnostics file.
+class MessageCollector
+    : public serialized_diags::SerializedDiagnosticReader {
+public:
+  std::vector<std::string> Messages;
+
+protected:
+  std::error_code
+  visitDiagnosticRecord(unsigned Severity,
+                        const serialized_diags::Location &Location,
+                        unsigned Category, unsigned Flag,
+                        StringRef Message) override {
+    Messages.push_back(Message);
+    return std::error_code();
+  }
+};
+
+TEST(DeduplicatingDiagnosticConsumerTest, SerializesEachDiagnosticOnce) {
+  SmallString<128> Path;
+  ASSERT_FALSE(
+      llvm::sys::fs::createTemporaryFile("dedup-diags", "dia", Path));
+
+  {
+    IntrusiveRefCntPtr<DiagnosticOptions> DiagOpts = new DiagnosticOptions();
+    DiagnosticsEngine Diags(
+        new DiagnosticIDs(), DiagOpts,
+        new DeduplicatingDiagnosticConsumer(
+            serialized_diags::create(Path, DiagOpts.get())));
+    Diags.Report(diag::warn_mt_message) << "first";
+    Diags.Report(diag::warn_mt_message) << "second";
+    Diags.Report(diag::warn_mt_message) << "first";
+    Diags.Report(diag::warn_mt_message) << "second";
+    Diags.getClient()->finish();
+  }
+
+  MessageCollector Reader;
+  EXPECT_FALSE(Reader.readDiagnostics(Path));
+  llvm::sys::fs::remove(Path);
+  ASSERT_EQ(2U, Reader.Messages.size());
+  EXPECT_EQ("[rewriter] first", Reader.Messages[0]);
+  EXPECT_EQ("[rewriter] second", Reader.Messages[1]);
+}
+
+} // anonymous namespace
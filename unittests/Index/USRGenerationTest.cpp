@@ -0,0 +1,127 @@
+//===- unittests/Index/USRGenerationTest.cpp - USR generation tests -------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Index/USRGeneration.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/RecursiveASTVisitor.h"
+#include "clang/Frontend/ASTUnit.h"
+#include "clang/Tooling/Tooling.h"
+#include "llvm/ADT/SmallString.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <vector>
+
+using namespace clang;
+using namespace clang::index;
+
+namespace {
+
+class DeclCollector : public RecursiveASTVisitor<DeclCollector> {
+public:
+  std::vector<const NamedDecl *> Decls;
+
+  bool VisitNamedDecl(NamedDecl *D) {
+    Decls.push_back(D);
+    return true;
+  }
+};
+
+std::unique_ptr<ASTUnit> buildAST(std::vector<const NamedDecl *> &Decls) {
+  // The long name makes USRs exceed the inline buffer of the hashing stream.
+  std::string LongName(300, 'x');
+  std::string Code = R"cpp(
+    namespace ns {
+    template <typename T> struct Box { T Value; void set(T); };
+    template <> struct Box<int> { int Value; };
+    struct { int Anonymous; } AnonymousVar;
+    enum E { A, B };
+    int f(int, ...);
+    void redeclared();
+    void redeclared();
+    }
+    void g() { int Local; }
+    int )cpp" + LongName + ";";
+
+  std::unique_ptr<ASTUnit> AST = tooling::buildASTFromCode(Code);
+  DeclCollector Collector;
+  Collector.TraverseDecl(AST->getASTContext().getTranslationUnitDecl());
+  Decls = std::move(Collector.Decls);
+  return AST;
+}
+
+TEST(USRGeneration, HashOfDeclMatchesHashOfUSR) {
+  std::vector<const NamedDecl *> Decls;
+  std::unique_ptr<ASTUnit> AST = buildAST(Decls);
+
+  unsigned NumHashed = 0;
+  for (const NamedDecl *D : Decls) {
+    SmallString<128> USR;
+    USRHash Hash;
+    bool Ignored = generateUSRForDecl(D, USR);
+    EXPECT_EQ(Ignored, generateUSRHashForDecl(D, Hash));
+    if (Ignored)
+      continue;
+    EXPECT_TRUE(hashUSR(USR) == Hash) << USR.str().str();
+    ++NumHashed;
+  }
+  EXPECT_GE(NumHashed, 10u);
+}
+
+TEST(USRGeneration, DifferentUSRsHaveDifferentHashes) {
+  EXPECT_TRUE(hashUSR("c:@F@f") != hashUSR("c:@F@g"));
+  EXPECT_TRUE(hashUSR("c:@F@f") == hashUSR("c:@F@f"));
+}
+
+TEST(USRGeneration, CacheMatchesUncachedUSRs) {
+  std::vector<const NamedDecl *> Decls;
+  std::unique_ptr<ASTUnit> AST = buildAST(Decls);
+
+  USRCache Cache;
+  for (unsigned I = 0, N = Decls.size(); I != N; ++I) {
+    const NamedDecl *D = Decls[I];
+    SmallString<128> Expected;
+    bool Ignored = generateUSRForDecl(D, Expected);
+
+    // Ask for the hash first for every other declaration, so both orders of
+    // filling the cache are covered.
+    USRHash Hash;
+    if (I % 2)
+      EXPECT_EQ(Ignored, Cache.getUSRHash(D, Hash));
+
+    StringRef First, Second;
+    EXPECT_EQ(Ignored, Cache.getUSR(D, First));
+    EXPECT_EQ(Ignored, Cache.getUSR(D, Second));
+    if (Ignored)
+      continue;
+    EXPECT_EQ(Expected.str(), First);
+    // The cached string is handed out again.
+    EXPECT_EQ(First.data(), Second.data());
+
+    if (!(I % 2))
+      EXPECT_FALSE(Cache.getUSRHash(D, Hash));
+    EXPECT_TRUE(hashUSR(Expected) == Hash) << Expected.str().str();
+  }
+}
+
+TEST(USRGeneration, CacheSharesUSRsOfRedeclarations) {
+  std::vector<const NamedDecl *> Decls;
+  std::unique_ptr<ASTUnit> AST = buildAST(Decls);
+
+  std::vector<StringRef> USRs;
+  USRCache Cache;
+  for (const NamedDecl *D : Decls) {
+    StringRef USR;
+    if (D->getNameAsString() == "redeclared" && !Cache.getUSR(D, USR))
+      USRs.push_back(USR);
+  }
+  ASSERT_EQ(2u, USRs.size());
+  EXPECT_EQ(USRs[0].data(), USRs[1].data());
+}
+
+} // anonymous namespace
@@ -365,4 +365,25 @@ TEST_F(LexerTest, DontMergeMacroArgsFromDifferentMacroFiles) {
   EXPECT_EQ(SourceMgr.getFileIDSize(SourceMgr.getFileID(helper1ArgLoc)), 8U);
 }
 
+TEST_F(LexerTest, HashedIdentifierLookup) {
+  unsigned Hash = 0;
+  for (char C : StringRef("identifier"))
+    Hash = IdentifierTable::extendHash(Hash, C);
+  EXPECT_EQ(IdentifierTable::hash("identifier"), Hash);
+
+  // Identifiers found through the lexer's hash, through the cache of recent
+  // identifiers, and through the slow path must agree.
+  std::vector<tok::TokenKind> ExpectedTokens;
+  ExpectedTokens.push_back(tok::kw_int);
+  ExpectedTokens.push_back(tok::identifier);
+  ExpectedTokens.push_back(tok::kw_int);
+  ExpectedTokens.push_back(tok::kw_int);
+  ExpectedTokens.push_back(tok::identifier);
+  ExpectedTokens.push_back(tok::identifier);
+
+  std::vector<Token> toks = CheckLex("int x int i\\\nnt x x$", ExpectedTokens);
+  EXPECT_EQ(toks[1].getIdentifierInfo(), toks[4].getIdentifierInfo());
+  EXPECT_NE(toks[4].getIdentifierInfo(), toks[5].getIdentifierInfo());
+}
+
 } // anonymous namespace